@@ -0,0 +1,200 @@
+#ifndef ARCHIVOGRAFO_H
+#define ARCHIVOGRAFO_H
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "ArchivoIndice.h"
+#include "Grafo.h"
+#include "Tokenizador.h"
+
+// Snapshot binario del grafo de co-relevancia y su PageRank, para no reprocesar el log de
+// consultas en cada arranque. Como en ArchivoIndice: cabecera fija y secciones alineadas a
+// 8 bytes, ademas de una suma de verificacion de la cabecera y de todas las secciones y la firma de las
+// entradas con que se construyo (quien lo abre decide si sigue valiendo). Al abrirlo el
+// archivo se mapea y los arreglos se copian al grafo, que sigue siendo modificable.
+namespace ArchivoGrafo {
+
+const char MAGIA[8] = {'G', 'R', 'A', 'F', 'O', 'P', 'R', '\0'};
+const uint32_t VERSION = 2;
+
+enum Seccion : uint32_t {
+    DESPLAZAMIENTOS, // uint64[numNodos + 1]
+    VECINOS,         // uint32[numVecinos]
+    PESOS,           // uint32[numVecinos]
+    URL_INICIO,      // uint64[numNodos + 1], URLs en orden de id de nodo
+    URL_TEXTO,       // char[]
+    PAGERANK,        // double[numNodos]
+    NUM_SECCIONES
+};
+
+using ArchivoIndice::DescriptorSeccion;
+
+struct Cabecera {
+    char magia[8];
+    uint32_t version;
+    uint32_t numSecciones;
+    uint64_t numNodos;
+    uint64_t numVecinos;   // entradas del CSR (dos por arista no dirigida)
+    uint64_t firma;        // firma de las entradas con que se construyo
+    uint64_t suma;         // suma de verificacion de las secciones y de la cabecera (con suma = 0)
+    int64_t iteraciones;   // del PageRank guardado
+    double residuo;
+    DescriptorSeccion secciones[NUM_SECCIONES];
+};
+
+// Suma de verificacion de 64 bits: mezcla 8 bytes por paso, los sobrantes de a uno
+inline uint64_t sumar(uint64_t h, const void* datos, size_t bytes) {
+    const unsigned char* p = static_cast<const unsigned char*>(datos);
+    size_t i = 0;
+    for (; i + 8 <= bytes; i += 8) {
+        uint64_t palabra;
+        std::memcpy(&palabra, p + i, 8);
+        h = (h ^ palabra) * 0x9E3779B97F4A7C15ull;
+        h ^= h >> 29;
+    }
+    for (; i < bytes; i++) h = (h ^ p[i]) * 0x100000001b3ull;
+    return h;
+}
+
+// Escribe la parte finalizada del grafo con su PageRank. Devuelve false si no se pudo escribir.
+inline bool guardar(const Grafo& grafo, const ResultadoPageRank& pagerank, uint64_t firma, const std::string& ruta) {
+    size_t N = grafo.numNodos();
+    std::vector<std::string_view> urls(N);
+    for (uint32_t u = 0; u < N; u++) urls[u] = grafo.url(u);
+    std::vector<uint64_t> urlInicio;
+    std::string urlTexto;
+    ArchivoIndice::empaquetarCadenas(urls, urlInicio, urlTexto);
+    std::vector<double> valores(pagerank.valores);
+    valores.resize(N, 0.0);
+    // El espacio libre del CSR (ver Grafo::holgura) no se guarda
+    std::vector<uint64_t> desplazamientosCompactos;
+    std::vector<uint32_t> vecinosCompactos, pesosCompactos;
+    if (!grafo.compacto()) grafo.copiarCompacto(desplazamientosCompactos, vecinosCompactos, pesosCompactos);
+    const std::vector<uint64_t>& desplazamientos = grafo.compacto() ? grafo.desplazamientos : desplazamientosCompactos;
+    const std::vector<uint32_t>& vecinos = grafo.compacto() ? grafo.vecinos : vecinosCompactos;
+    const std::vector<uint32_t>& pesos = grafo.compacto() ? grafo.pesos : pesosCompactos;
+
+    struct Bloque { const void* datos; uint64_t bytes; };
+    Bloque bloques[NUM_SECCIONES] = {
+        {desplazamientos.data(), desplazamientos.size() * sizeof(uint64_t)},
+        {vecinos.data(), vecinos.size() * sizeof(uint32_t)},
+        {pesos.data(), pesos.size() * sizeof(uint32_t)},
+        {urlInicio.data(), urlInicio.size() * sizeof(uint64_t)},
+        {urlTexto.data(), urlTexto.size()},
+        {valores.data(), valores.size() * sizeof(double)},
+    };
+
+    Cabecera cab;
+    std::memset(&cab, 0, sizeof(cab));
+    std::memcpy(cab.magia, MAGIA, sizeof(MAGIA));
+    cab.version = VERSION;
+    cab.numSecciones = NUM_SECCIONES;
+    cab.numNodos = N;
+    cab.numVecinos = vecinos.size();
+    cab.firma = firma;
+    cab.iteraciones = pagerank.iteraciones;
+    cab.residuo = pagerank.residuo;
+    uint64_t offset = sizeof(Cabecera);
+    uint64_t suma = 0;
+    for (uint32_t s = 0; s < NUM_SECCIONES; s++) {
+        offset = (offset + 7) & ~uint64_t(7);
+        cab.secciones[s] = {offset, bloques[s].bytes};
+        offset += bloques[s].bytes;
+        suma = sumar(suma, bloques[s].datos, bloques[s].bytes);
+    }
+    cab.suma = sumar(suma, &cab, sizeof(cab));
+
+    std::ofstream out(ruta, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "❌ No se pudo crear " << ruta << std::endl;
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(&cab), sizeof(cab));
+    uint64_t escrito = sizeof(Cabecera);
+    const char relleno[8] = {0};
+    for (uint32_t s = 0; s < NUM_SECCIONES; s++) {
+        out.write(relleno, static_cast<std::streamsize>(cab.secciones[s].offset - escrito));
+        if (bloques[s].bytes > 0) {
+            out.write(static_cast<const char*>(bloques[s].datos), static_cast<std::streamsize>(bloques[s].bytes));
+        }
+        escrito = cab.secciones[s].offset + bloques[s].bytes;
+    }
+    out.close();
+    return !out.fail();
+}
+
+// Abre un snapshot: mapea el archivo, comprueba cabecera, tamanos y suma de verificacion,
+// y reemplaza el grafo y el PageRank. Devuelve false (sin tocarlos) si el archivo no
+// existe, es de otra version o esta corrupto; 'firma' queda con la del archivo.
+inline bool abrir(Grafo& grafo, ResultadoPageRank& pagerank, uint64_t& firma, const std::string& ruta) {
+    ArchivoMapeado archivo;
+    if (!archivo.abrir(ruta) || archivo.size() < sizeof(Cabecera)) return false;
+
+    Cabecera cab;
+    std::memcpy(&cab, archivo.data(), sizeof(cab));
+    if (std::memcmp(cab.magia, MAGIA, sizeof(MAGIA)) != 0) {
+        std::cerr << "⚠️ " << ruta << " no es un snapshot del grafo\n";
+        return false;
+    }
+    if (cab.version != VERSION || cab.numSecciones != NUM_SECCIONES) {
+        std::cerr << "⚠️ " << ruta << " tiene version " << cab.version << " (se esperaba " << VERSION << ")\n";
+        return false;
+    }
+    uint64_t esperados[NUM_SECCIONES] = {
+        (cab.numNodos + 1) * sizeof(uint64_t), cab.numVecinos * sizeof(uint32_t), cab.numVecinos * sizeof(uint32_t),
+        (cab.numNodos + 1) * sizeof(uint64_t), 0, cab.numNodos * sizeof(double),
+    };
+    uint64_t suma = 0;
+    for (uint32_t s = 0; s < NUM_SECCIONES; s++) {
+        const DescriptorSeccion& d = cab.secciones[s];
+        bool tamanoValido = esperados[s] == 0 || d.bytes == esperados[s];
+        if (d.offset % 8 != 0 || d.offset + d.bytes > archivo.size() || !tamanoValido) {
+            std::cerr << "⚠️ " << ruta << " esta corrupto (seccion " << s << ")\n";
+            return false;
+        }
+        suma = sumar(suma, archivo.data() + d.offset, d.bytes);
+    }
+    Cabecera sinSuma = cab;
+    sinSuma.suma = 0;
+    if (sumar(suma, &sinSuma, sizeof(sinSuma)) != cab.suma) {
+        std::cerr << "⚠️ " << ruta << " esta corrupto (suma de verificacion)\n";
+        return false;
+    }
+
+    auto seccion = [&](uint32_t s) { return archivo.data() + cab.secciones[s].offset; };
+    const uint64_t* desplazamientos = reinterpret_cast<const uint64_t*>(seccion(DESPLAZAMIENTOS));
+    const uint64_t* urlInicio = reinterpret_cast<const uint64_t*>(seccion(URL_INICIO));
+    if (desplazamientos[0] != 0 || desplazamientos[cab.numNodos] != cab.numVecinos || urlInicio[cab.numNodos] != cab.secciones[URL_TEXTO].bytes) {
+        std::cerr << "⚠️ " << ruta << " esta corrupto (arreglos CSR)\n";
+        return false;
+    }
+
+    Grafo nuevo;
+    const char* urlTexto = seccion(URL_TEXTO);
+    for (uint64_t u = 0; u < cab.numNodos; u++) {
+        if (nuevo.nodo(std::string_view(urlTexto + urlInicio[u], urlInicio[u + 1] - urlInicio[u])) != u) {
+            std::cerr << "⚠️ " << ruta << " esta corrupto (URL repetida)\n";
+            return false;
+        }
+    }
+    const uint32_t* vecinos = reinterpret_cast<const uint32_t*>(seccion(VECINOS));
+    const uint32_t* pesos = reinterpret_cast<const uint32_t*>(seccion(PESOS));
+    const double* valores = reinterpret_cast<const double*>(seccion(PAGERANK));
+    nuevo.asignarCSR(std::vector<uint64_t>(desplazamientos, desplazamientos + cab.numNodos + 1),
+                     std::vector<uint32_t>(vecinos, vecinos + cab.numVecinos), std::vector<uint32_t>(pesos, pesos + cab.numVecinos));
+
+    grafo = std::move(nuevo);
+    pagerank.valores.assign(valores, valores + cab.numNodos);
+    pagerank.iteraciones = static_cast<int>(cab.iteraciones);
+    pagerank.residuo = cab.residuo;
+    firma = cab.firma;
+    return true;
+}
+
+} // namespace ArchivoGrafo
+
+#endif // ARCHIVOGRAFO_H
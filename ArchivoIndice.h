@@ -0,0 +1,270 @@
+#ifndef ARCHIVOINDICE_H
+#define ARCHIVOINDICE_H
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Indice.h"
+#include "Tokenizador.h"
+
+// Formato binario del indice invertido (un archivo por corpus).
+// Cabecera fija seguida de secciones alineadas a 8 bytes; cada seccion es un arreglo
+// plano que se usa directamente desde el archivo mapeado, sin copiarlo.
+namespace ArchivoIndice {
+
+const char MAGIA[8] = {'I', 'D', 'X', 'I', 'N', 'V', '\0', '\0'};
+const uint32_t VERSION = 5;
+
+enum Seccion : uint32_t {
+    URL_INICIO,      // uint64[numDocs + 1]
+    URL_TEXTO,       // char[]
+    LONGITUDES,      // uint32[numDocs]
+    TERMINO_INICIO,  // uint64[numTerminos + 1], terminos en orden de termID
+    TERMINO_TEXTO,   // char[]
+    BLOQUES_INICIO,  // uint64[numTerminos + 1]
+    BLOQUES,         // BloquePostings[numBloques]
+    DATOS_POSTINGS,  // uint8[] bloques comprimidos
+    STOPWORD_INICIO, // uint64[numStopwords + 1]
+    STOPWORD_TEXTO,  // char[]
+    COTAS_TERMINO,   // double[numTerminos], cota BM25 sin idf de cada termino
+    NUM_SECCIONES
+};
+
+struct DescriptorSeccion {
+    uint64_t offset;
+    uint64_t bytes;
+};
+
+struct Cabecera {
+    char magia[8];
+    uint32_t version;
+    uint32_t numSecciones;
+    uint64_t numDocumentos;
+    uint64_t numTerminos;
+    uint64_t numPostings;
+    uint64_t numBloques;
+    uint64_t totalTerminos;
+    uint64_t numStopwords;
+    double k1Cotas; // parametros de BM25 con los que se calcularon las cotas por termino
+    double bCotas;
+    uint64_t bytesCorpus; // version del corpus con el que se construyo (ver versionDe)
+    int64_t fechaCorpus;
+    DescriptorSeccion secciones[NUM_SECCIONES];
+};
+
+// Tamano y fecha de modificacion de un archivo (0 si no existe): identifican su version sin leerlo
+struct VersionArchivo {
+    uint64_t bytes = 0;
+    int64_t fecha = 0;
+};
+
+inline VersionArchivo versionDe(const std::string& ruta) {
+    VersionArchivo version;
+    std::error_code error;
+    uint64_t bytes = std::filesystem::file_size(ruta, error);
+    if (error) return version;
+    auto fecha = std::filesystem::last_write_time(ruta, error);
+    if (error) return version;
+    version.bytes = bytes;
+    version.fecha = static_cast<int64_t>(fecha.time_since_epoch().count());
+    return version;
+}
+
+// Concatena cadenas en un bloque de texto con su arreglo de inicios
+template <typename Cadenas>
+void empaquetarCadenas(const Cadenas& cadenas, std::vector<uint64_t>& inicio, std::string& texto) {
+    inicio.assign(1, 0);
+    for (const auto& c : cadenas) {
+        texto.append(c.data(), c.size());
+        inicio.push_back(texto.size());
+    }
+}
+
+// Escribe el indice (ya finalizado) de 'corpus' en disco, con la version del corpus.
+// Devuelve false si no se pudo escribir.
+inline bool guardar(const Indice& indice, const std::string& ruta, const std::string& corpus) {
+    std::vector<std::string_view> porTermID(indice.numTerminos());
+    for (const auto& par : indice.terminos) porTermID[par.second] = par.first;
+
+    std::vector<uint64_t> terminoInicio, stopwordInicio;
+    std::string terminoTexto, stopwordTexto;
+    empaquetarCadenas(porTermID, terminoInicio, terminoTexto);
+    empaquetarCadenas(indice.stopwords, stopwordInicio, stopwordTexto);
+
+    const TablaDocumentos& docs = indice.documentos;
+    struct Bloque { const void* datos; uint64_t bytes; };
+    Bloque bloques[NUM_SECCIONES] = {
+        {docs.inicioUrl.data(), docs.inicioUrl.size() * sizeof(uint64_t)},
+        {docs.textoUrls.data(), docs.textoUrls.size()},
+        {docs.longitudes.data(), docs.longitudes.size() * sizeof(uint32_t)},
+        {terminoInicio.data(), terminoInicio.size() * sizeof(uint64_t)},
+        {terminoTexto.data(), terminoTexto.size()},
+        {indice.inicioBloques.data(), indice.inicioBloques.size() * sizeof(uint64_t)},
+        {indice.bloques.data(), indice.bloques.size() * sizeof(Compresion::BloquePostings)},
+        {indice.datosPostings.data(), indice.datosPostings.size()},
+        {stopwordInicio.data(), stopwordInicio.size() * sizeof(uint64_t)},
+        {stopwordTexto.data(), stopwordTexto.size()},
+        {indice.cotaTerminos.data(), indice.cotaTerminos.size() * sizeof(double)},
+    };
+
+    Cabecera cab;
+    std::memset(&cab, 0, sizeof(cab));
+    std::memcpy(cab.magia, MAGIA, sizeof(MAGIA));
+    cab.version = VERSION;
+    cab.numSecciones = NUM_SECCIONES;
+    cab.numDocumentos = indice.numDocumentos();
+    cab.numTerminos = indice.numTerminos();
+    cab.numPostings = indice.numPostings();
+    cab.numBloques = indice.bloques.size();
+    cab.totalTerminos = indice.totalTerminos;
+    cab.numStopwords = indice.stopwords.size();
+    cab.k1Cotas = indice.parametrosCotas.k1;
+    cab.bCotas = indice.parametrosCotas.b;
+    VersionArchivo version = versionDe(corpus);
+    cab.bytesCorpus = version.bytes;
+    cab.fechaCorpus = version.fecha;
+    uint64_t offset = sizeof(Cabecera);
+    for (uint32_t s = 0; s < NUM_SECCIONES; s++) {
+        offset = (offset + 7) & ~uint64_t(7);
+        cab.secciones[s] = {offset, bloques[s].bytes};
+        offset += bloques[s].bytes;
+    }
+
+    std::ofstream out(ruta, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "❌ No se pudo crear " << ruta << std::endl;
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(&cab), sizeof(cab));
+    uint64_t escrito = sizeof(Cabecera);
+    const char relleno[8] = {0};
+    for (uint32_t s = 0; s < NUM_SECCIONES; s++) {
+        out.write(relleno, static_cast<std::streamsize>(cab.secciones[s].offset - escrito));
+        if (bloques[s].bytes > 0) {
+            out.write(static_cast<const char*>(bloques[s].datos), static_cast<std::streamsize>(bloques[s].bytes));
+        }
+        escrito = cab.secciones[s].offset + bloques[s].bytes;
+    }
+    out.close();
+    return !out.fail();
+}
+
+// Inicios de 'n' cadenas (n + 1 posiciones) no decrecientes y dentro de 'bytes' de texto
+inline bool iniciosValidos(const uint64_t* inicio, uint64_t n, uint64_t bytes) {
+    if (inicio[0] != 0 || inicio[n] != bytes) return false;
+    for (uint64_t i = 0; i < n; i++) {
+        if (inicio[i] > inicio[i + 1]) return false;
+    }
+    return true;
+}
+
+// Metadatos de los bloques: cada termino tiene sus bloques en orden y con docIDs
+// crecientes y menores que numDocs, y cada bloque (con sus docIDs y frecuencias) cae
+// dentro de los datos comprimidos, antes del bloque siguiente. No se leen los datos.
+inline bool bloquesValidos(const Cabecera& cab, const uint64_t* inicioBloques, const Compresion::BloquePostings* bloques, uint64_t bytesDatos) {
+    if (inicioBloques[0] != 0 || inicioBloques[cab.numTerminos] != cab.numBloques) return false;
+    uint64_t postings = 0;
+    for (uint64_t t = 0; t < cab.numTerminos; t++) {
+        if (inicioBloques[t] > inicioBloques[t + 1]) return false;
+        for (uint64_t b = inicioBloques[t]; b < inicioBloques[t + 1]; b++) {
+            const Compresion::BloquePostings& bloque = bloques[b];
+            uint64_t fin = b + 1 < cab.numBloques ? bloques[b + 1].offset : bytesDatos;
+            bool ultimo = b + 1 == inicioBloques[t + 1];
+            if (bloque.cantidad == 0 || bloque.cantidad > Compresion::TAM_BLOQUE || (!ultimo && bloque.cantidad != Compresion::TAM_BLOQUE)) return false;
+            if (bloque.codec != Compresion::VARINT && bloque.codec != Compresion::BITPACK) return false;
+            if (bloque.offset >= fin || fin > bytesDatos || bloque.bytesDocs == 0 || bloque.bytesDocs >= fin - bloque.offset) return false;
+            if (bloque.ultimoDocID >= cab.numDocumentos || (b > inicioBloques[t] && bloque.ultimoDocID <= bloques[b - 1].ultimoDocID)) return false;
+            postings += bloque.cantidad;
+        }
+    }
+    return postings == cab.numPostings;
+}
+
+// Abre un indice guardado: mapea el archivo, apunta los arreglos a sus secciones y
+// carga solo el diccionario de terminos en memoria. Devuelve false si el archivo
+// no existe, es de otra version, esta truncado o corrupto, o (con 'corpus') se
+// construyo con otra version del corpus: en ese caso hay que reconstruirlo.
+inline bool abrir(Indice& indice, const std::string& ruta, const std::string& corpus = std::string()) {
+    auto archivo = std::make_shared<ArchivoMapeado>();
+    if (!archivo->abrir(ruta) || archivo->size() < sizeof(Cabecera)) return false;
+
+    Cabecera cab;
+    std::memcpy(&cab, archivo->data(), sizeof(cab));
+    if (std::memcmp(cab.magia, MAGIA, sizeof(MAGIA)) != 0) {
+        std::cerr << "⚠️ " << ruta << " no es un archivo de indice\n";
+        return false;
+    }
+    if (cab.version != VERSION || cab.numSecciones != NUM_SECCIONES) {
+        std::cerr << "⚠️ " << ruta << " tiene version " << cab.version << " (se esperaba " << VERSION << ")\n";
+        return false;
+    }
+    uint64_t esperados[NUM_SECCIONES] = {
+        (cab.numDocumentos + 1) * sizeof(uint64_t), 0, cab.numDocumentos * sizeof(uint32_t),
+        (cab.numTerminos + 1) * sizeof(uint64_t), 0, (cab.numTerminos + 1) * sizeof(uint64_t),
+        cab.numBloques * sizeof(Compresion::BloquePostings), 0,
+        (cab.numStopwords + 1) * sizeof(uint64_t), 0, cab.numTerminos * sizeof(double),
+    };
+    for (uint32_t s = 0; s < NUM_SECCIONES; s++) {
+        const DescriptorSeccion& d = cab.secciones[s];
+        bool tamanoValido = esperados[s] == 0 || d.bytes == esperados[s];
+        if (d.offset % 8 != 0 || d.offset + d.bytes > archivo->size() || !tamanoValido) {
+            std::cerr << "⚠️ " << ruta << " esta corrupto (seccion " << s << ")\n";
+            return false;
+        }
+    }
+
+    if (!corpus.empty()) {
+        VersionArchivo version = versionDe(corpus);
+        if (version.bytes != cab.bytesCorpus || version.fecha != cab.fechaCorpus) {
+            std::cerr << "⚠️ " << ruta << " se construyo con otra version de " << corpus << "\n";
+            return false;
+        }
+    }
+
+    auto seccion = [&](uint32_t s) { return archivo->data() + cab.secciones[s].offset; };
+    auto como64 = [&](uint32_t s) { return reinterpret_cast<const uint64_t*>(seccion(s)); };
+    auto como32 = [&](uint32_t s) { return reinterpret_cast<const uint32_t*>(seccion(s)); };
+    auto bloquesArchivo = reinterpret_cast<const Compresion::BloquePostings*>(seccion(BLOQUES));
+    if (!iniciosValidos(como64(URL_INICIO), cab.numDocumentos, cab.secciones[URL_TEXTO].bytes) ||
+        !iniciosValidos(como64(TERMINO_INICIO), cab.numTerminos, cab.secciones[TERMINO_TEXTO].bytes) ||
+        !iniciosValidos(como64(STOPWORD_INICIO), cab.numStopwords, cab.secciones[STOPWORD_TEXTO].bytes) ||
+        !bloquesValidos(cab, como64(BLOQUES_INICIO), bloquesArchivo, cab.secciones[DATOS_POSTINGS].bytes)) {
+        std::cerr << "⚠️ " << ruta << " esta corrupto (postings o cadenas fuera de su seccion)\n";
+        return false;
+    }
+
+    indice = Indice();
+    indice.documentos.inicioUrl.mapear(como64(URL_INICIO), cab.numDocumentos + 1);
+    indice.documentos.textoUrls.mapear(seccion(URL_TEXTO), cab.secciones[URL_TEXTO].bytes);
+    indice.documentos.longitudes.mapear(como32(LONGITUDES), cab.numDocumentos);
+    indice.inicioBloques.mapear(como64(BLOQUES_INICIO), cab.numTerminos + 1);
+    indice.bloques.mapear(bloquesArchivo, cab.numBloques);
+    indice.datosPostings.mapear(reinterpret_cast<const uint8_t*>(seccion(DATOS_POSTINGS)), cab.secciones[DATOS_POSTINGS].bytes);
+    indice.cotaTerminos.mapear(reinterpret_cast<const double*>(seccion(COTAS_TERMINO)), cab.numTerminos);
+    indice.parametrosCotas.k1 = cab.k1Cotas;
+    indice.parametrosCotas.b = cab.bCotas;
+    indice.totalPostings = cab.numPostings;
+    indice.totalTerminos = cab.totalTerminos;
+
+    const uint64_t* terminoInicio = como64(TERMINO_INICIO);
+    const char* terminoTexto = seccion(TERMINO_TEXTO);
+    indice.terminos.reserve(cab.numTerminos);
+    for (uint64_t t = 0; t < cab.numTerminos; t++) {
+        indice.terminos.emplace(std::string(terminoTexto + terminoInicio[t], terminoInicio[t + 1] - terminoInicio[t]), static_cast<uint32_t>(t));
+    }
+    const uint64_t* stopwordInicio = como64(STOPWORD_INICIO);
+    const char* stopwordTexto = seccion(STOPWORD_TEXTO);
+    for (uint64_t i = 0; i < cab.numStopwords; i++) {
+        indice.stopwords.emplace_back(stopwordTexto + stopwordInicio[i], stopwordInicio[i + 1] - stopwordInicio[i]);
+    }
+    indice.archivo = archivo;
+    return true;
+}
+
+} // namespace ArchivoIndice
+
+#endif // ARCHIVOINDICE_H
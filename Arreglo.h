@@ -0,0 +1,100 @@
+#ifndef ARREGLO_H
+#define ARREGLO_H
+#include <cstddef>
+#include <vector>
+
+// Arreglo contiguo que es dueno de sus datos (mientras se construye) o es una vista
+// de solo lectura sobre memoria ajena, por ejemplo un archivo mapeado.
+template <typename T>
+class Arreglo {
+private:
+    std::vector<T> propio;
+    const T* datos = nullptr;
+    size_t n = 0;
+
+    void sincronizar() {
+        datos = propio.data();
+        n = propio.size();
+    }
+
+public:
+    Arreglo() {}
+    Arreglo(const Arreglo& otro) { *this = otro; }
+    Arreglo(Arreglo&& otro) noexcept { *this = std::move(otro); }
+
+    Arreglo& operator=(const Arreglo& otro) {
+        if (this == &otro) return *this;
+        if (otro.esVista()) {
+            propio.clear();
+            datos = otro.datos;
+            n = otro.n;
+        } else {
+            propio = otro.propio;
+            sincronizar();
+        }
+        return *this;
+    }
+
+    Arreglo& operator=(Arreglo&& otro) noexcept {
+        if (this == &otro) return *this;
+        bool vista = otro.esVista();
+        propio = std::move(otro.propio);
+        if (vista) {
+            datos = otro.datos;
+            n = otro.n;
+        } else {
+            sincronizar();
+        }
+        otro.datos = nullptr;
+        otro.n = 0;
+        return *this;
+    }
+
+    // Toma posesion de un vector ya construido
+    void asignar(std::vector<T>&& v) {
+        propio = std::move(v);
+        sincronizar();
+    }
+
+    // Apunta a memoria externa sin copiarla (debe sobrevivir al arreglo)
+    void mapear(const T* p, size_t cantidad) {
+        propio.clear();
+        propio.shrink_to_fit();
+        datos = p;
+        n = cantidad;
+    }
+
+    void push_back(const T& v) {
+        propio.push_back(v);
+        sincronizar();
+    }
+
+    void agregar(const T* p, size_t cantidad) {
+        propio.insert(propio.end(), p, p + cantidad);
+        sincronizar();
+    }
+
+    void reserve(size_t cantidad) {
+        propio.reserve(cantidad);
+        sincronizar();
+    }
+
+    void clear() {
+        propio.clear();
+        sincronizar();
+    }
+
+    // Acceso de escritura, solo valido cuando el arreglo es propio
+    T& mutable_at(size_t i) { return propio[i]; }
+
+    bool esVista() const { return datos != nullptr && datos != propio.data(); }
+    const T& operator[](size_t i) const { return datos[i]; }
+    const T* data() const { return datos; }
+    size_t size() const { return n; }
+    bool empty() const { return n == 0; }
+    const T* begin() const { return datos; }
+    const T* end() const { return datos + n; }
+    const T& back() const { return datos[n - 1]; }
+};
+
+#endif // ARREGLO_H
@@ -0,0 +1,30 @@
+#ifndef BUSQUEDA_H
+#define BUSQUEDA_H
+#include "Evaluacion.h"
+#include "Indice.h"
+#include "Ranking.h"
+#include "RankingEstatico.h"
+
+// Funcion de busqueda: union (OR) o interseccion (AND) de documentos segun el modo.
+// Se evalua la forma canonica de la consulta, una sola vez; el resultado sirve para
+// el cache, para el texto de salida y para el grafo. Con un indice ordenado por PageRank
+// y una fusion, el puntaje combina BM25 con el PageRank de cada documento.
+inline ResultadoConsulta busqueda(const Indice& indice, const BM25& bm25, ModoConsulta modo, const ConsultaNormalizada& consulta, const IndiceEstatico* estatico = nullptr, const OpcionesFusion& fusion = OpcionesFusion()) {
+    ResultadoConsulta resultado;
+    // Validacion de que al menos exista una palabra valida
+    if (consulta.terminos.empty()) {
+        resultado.sinPalabras = true;
+        return resultado;
+    }
+
+    // Puntaje BM25 de los documentos relacionados; solo los 10 mas relevantes, ya ordenados
+    if (estatico != nullptr && fusion.tipo != Fusion::NINGUNA) {
+        resultado = ResultadoConsulta::desde(estatico->evaluar(bm25, consulta.terminos, modo, 10, fusion));
+    } else {
+        resultado = ResultadoConsulta::desde(evaluarConsulta(indice, bm25, consulta.terminos, modo, 10));
+    }
+
+    return resultado;
+}
+
+#endif // BUSQUEDA_H
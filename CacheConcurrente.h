@@ -0,0 +1,177 @@
+#ifndef CACHECONCURRENTE_H
+#define CACHECONCURRENTE_H
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "PoliticasCache.h"
+
+// Contadores de un fragmento del cache
+struct EstadisticasFragmento {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t inserciones = 0;
+    uint64_t reemplazos = 0;
+    int elementos = 0;
+    size_t bytes = 0;
+};
+
+// Cache de consultas seguro entre hilos.
+// Las claves se reparten por hash entre N fragmentos; cada uno tiene su propio mutex,
+// su cache (con la politica de desalojo elegida) y sus contadores, asi que hilos con
+// claves distintas casi nunca compiten. La politica es exacta dentro de cada fragmento
+// (aproximada a nivel global).
+template <typename Valor, typename Clave = std::string>
+class CacheConcurrente {
+private:
+    struct Fragmento {
+        std::mutex mutex;
+        std::unique_ptr<CacheBase<Valor, Clave>> cache;
+        EstadisticasFragmento stats;
+        Fragmento(const std::string& politica, size_t capacidad) : cache(crearCache<Valor, Clave>(politica, capacidad)) {}
+    };
+    std::vector<std::unique_ptr<Fragmento>> fragmentos;
+    size_t maxBytes;
+
+    // Se mezclan los bits altos del hash: los bajos ya los usa la tabla de cada fragmento
+    Fragmento& fragmentoDe(const Clave& key) {
+        uint64_t h = hashClave(key) * 0x9E3779B97F4A7C15ull;
+        return *fragmentos[(h >> 32) % fragmentos.size()];
+    }
+
+public:
+    // La capacidad total (en bytes) se divide en partes iguales entre los fragmentos
+    CacheConcurrente(size_t capacidadBytes, unsigned numFragmentos, const std::string& politica = "lru") {
+        numFragmentos = std::max(1u, numFragmentos);
+        size_t porFragmento = capacidadBytes / numFragmentos;
+        for (unsigned f = 0; f < numFragmentos; f++) {
+            fragmentos.emplace_back(new Fragmento(politica, porFragmento));
+        }
+        maxBytes = porFragmento * numFragmentos;
+    }
+
+    // Busca la clave y cuenta el hit o miss en su fragmento
+    bool buscar(const Clave& key, Valor& value) {
+        Fragmento& f = fragmentoDe(key);
+        std::lock_guard<std::mutex> lock(f.mutex);
+        if (f.cache->get(key, value)) {
+            f.stats.hits++;
+            return true;
+        }
+        f.stats.misses++;
+        return false;
+    }
+
+    // Inserta o actualiza; cuenta inserciones y reemplazos en el fragmento.
+    // Devuelve cuantas entradas se desalojaron para hacerle lugar.
+    int insertar(const Clave& key, const Valor& value) {
+        Fragmento& f = fragmentoDe(key);
+        std::lock_guard<std::mutex> lock(f.mutex);
+        int desalojados = f.cache->put(key, value);
+        f.stats.inserciones++;
+        f.stats.reemplazos += desalojados;
+        return desalojados;
+    }
+
+    // Interfaz de CacheBase (sin contadores)
+    Valor get(const Clave& key) {
+        Fragmento& f = fragmentoDe(key);
+        std::lock_guard<std::mutex> lock(f.mutex);
+        return f.cache->get(key);
+    }
+
+    int put(const Clave& key, const Valor& value) {
+        Fragmento& f = fragmentoDe(key);
+        std::lock_guard<std::mutex> lock(f.mutex);
+        return f.cache->put(key, value);
+    }
+
+    bool contains(const Clave& key) {
+        Fragmento& f = fragmentoDe(key);
+        std::lock_guard<std::mutex> lock(f.mutex);
+        return f.cache->contains(key);
+    }
+
+    int getSize() {
+        int total = 0;
+        for (auto& f : fragmentos) {
+            std::lock_guard<std::mutex> lock(f->mutex);
+            total += f->cache->getSize();
+        }
+        return total;
+    }
+
+    size_t getBytes() {
+        size_t total = 0;
+        for (auto& f : fragmentos) {
+            std::lock_guard<std::mutex> lock(f->mutex);
+            total += f->cache->getBytes();
+        }
+        return total;
+    }
+
+    size_t getMaxBytes() const {
+        return maxBytes;
+    }
+
+    // Claves de cada fragmento, del mas reciente al menos reciente dentro del fragmento
+    std::vector<Clave> getAllKeys() {
+        std::vector<Clave> keys;
+        for (auto& f : fragmentos) {
+            std::lock_guard<std::mutex> lock(f->mutex);
+            std::vector<Clave> parte = f->cache->getAllKeys();
+            keys.insert(keys.end(), parte.begin(), parte.end());
+        }
+        return keys;
+    }
+
+    // Aplica 'transformacion' a cada valor de todos los fragmentos, sin tocar el orden de
+    // uso ni los contadores
+    void transformar(const std::function<void(Valor&)>& transformacion) {
+        for (auto& f : fragmentos) {
+            std::lock_guard<std::mutex> lock(f->mutex);
+            f->cache->transformar(transformacion);
+        }
+    }
+
+    void clear() {
+        for (auto& f : fragmentos) {
+            std::lock_guard<std::mutex> lock(f->mutex);
+            f->cache->clear();
+            f->stats = EstadisticasFragmento();
+        }
+    }
+
+    size_t numFragmentos() const { return fragmentos.size(); }
+    const char* politica() const { return fragmentos.front()->cache->politica(); }
+
+    std::vector<EstadisticasFragmento> estadisticas() {
+        std::vector<EstadisticasFragmento> out;
+        for (auto& f : fragmentos) {
+            std::lock_guard<std::mutex> lock(f->mutex);
+            out.push_back(f->stats);
+            out.back().elementos = f->cache->getSize();
+            out.back().bytes = f->cache->getBytes();
+        }
+        return out;
+    }
+
+    // Suma de los contadores de todos los fragmentos
+    EstadisticasFragmento total() {
+        EstadisticasFragmento suma;
+        for (const auto& s : estadisticas()) {
+            suma.hits += s.hits;
+            suma.misses += s.misses;
+            suma.inserciones += s.inserciones;
+            suma.reemplazos += s.reemplazos;
+            suma.elementos += s.elementos;
+            suma.bytes += s.bytes;
+        }
+        return suma;
+    }
+};
+
+#endif // CACHECONCURRENTE_H
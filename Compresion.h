@@ -0,0 +1,322 @@
+#ifndef COMPRESION_H
+#define COMPRESION_H
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#if defined(__x86_64__) || defined(_M_X64)
+#define COMPRESION_X86 1
+#include <emmintrin.h>
+#if defined(__GNUC__)
+#include <immintrin.h>
+#endif
+#endif
+
+// Compresion de postings por bloques de 128 docIDs.
+// Cada bloque guarda los gaps entre docIDs consecutivos y las frecuencias (tf - 1),
+// codificados en varint o en bit-packing con ancho fijo por bloque (el que ocupe menos).
+// El bit-packing usa una disposicion vertical de 8 carriles: el valor i va en el carril
+// i % 8, asi que cada fila de 8 palabras desempaca 8 valores consecutivos y el mismo
+// codigo sirve para SSE2 (dos mitades de 4), AVX2 (una fila completa) y escalar.
+namespace Compresion {
+
+const uint32_t TAM_BLOQUE = 128;
+const uint32_t CARRILES = 8;
+const uint32_t VALORES_POR_CARRIL = TAM_BLOQUE / CARRILES;
+
+enum Codec : uint8_t {
+    VARINT = 0,
+    BITPACK = 1,
+};
+
+// Metadatos de un bloque (24 bytes); el ultimo docID funciona como skip pointer.
+// En BITPACK, cada parte (docIDs y frecuencias) empieza con un byte con su ancho en bits.
+// maxTf y minLongitud acotan el puntaje de cualquier documento del bloque (block-max):
+// BM25 crece con tf y decrece con la longitud, asi que la cota vale para cualquier k1 y b.
+struct BloquePostings {
+    uint64_t offset;       // inicio del bloque en los datos comprimidos
+    uint32_t ultimoDocID;  // mayor docID del bloque
+    uint16_t bytesDocs;    // bytes de los docIDs (las frecuencias empiezan despues)
+    uint8_t cantidad;      // postings en el bloque (hasta 128)
+    uint8_t codec;
+    uint32_t maxTf;        // mayor frecuencia del bloque
+    uint32_t minLongitud;  // menor longitud de documento del bloque
+};
+// ArchivoIndice escribe los bloques tal cual: cambiar su tamano cambia el formato en disco
+static_assert(sizeof(BloquePostings) == 24, "BloquePostings debe ocupar 24 bytes");
+
+inline uint32_t bitsNecesarios(uint32_t v) {
+    uint32_t bits = 0;
+    while (v != 0) { bits++; v >>= 1; }
+    return bits;
+}
+
+inline uint32_t palabrasPorCarril(uint32_t bits) {
+    return (VALORES_POR_CARRIL * bits + 31) / 32;
+}
+
+// ---------- varint ----------
+
+inline void escribirVarint(uint32_t v, std::vector<uint8_t>& out) {
+    while (v >= 0x80) {
+        out.push_back(static_cast<uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(v));
+}
+
+inline const uint8_t* leerVarint(const uint8_t* p, uint32_t& v) {
+    v = 0;
+    for (uint32_t shift = 0;; shift += 7) {
+        uint8_t byte = *p++;
+        v |= static_cast<uint32_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) return p;
+    }
+}
+
+inline size_t bytesVarint(uint32_t v) {
+    size_t n = 1;
+    while (v >= 0x80) { n++; v >>= 7; }
+    return n;
+}
+
+// ---------- bit-packing vertical ----------
+
+// Empaqueta 128 valores con 'bits' bits cada uno
+inline void empacar(const uint32_t* valores, uint32_t bits, std::vector<uint8_t>& out) {
+    if (bits == 0) return; // todos los valores son 0, no ocupan espacio
+    uint32_t wpc = palabrasPorCarril(bits);
+    std::vector<uint32_t> palabras(wpc * CARRILES, 0);
+    for (uint32_t i = 0; i < TAM_BLOQUE; i++) {
+        uint32_t carril = i % CARRILES;
+        uint32_t bit = (i / CARRILES) * bits;
+        uint32_t w = bit / 32, desp = bit % 32;
+        palabras[w * CARRILES + carril] |= valores[i] << desp;
+        if (desp + bits > 32) {
+            palabras[(w + 1) * CARRILES + carril] |= valores[i] >> (32 - desp);
+        }
+    }
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(palabras.data());
+    out.insert(out.end(), bytes, bytes + palabras.size() * sizeof(uint32_t));
+}
+
+inline void desempacarEscalar(const uint32_t* palabras, uint32_t bits, uint32_t* out) {
+    uint32_t mascara = bits == 32 ? 0xFFFFFFFFu : ((1u << bits) - 1);
+    for (uint32_t k = 0; k < VALORES_POR_CARRIL; k++) {
+        uint32_t bit = k * bits;
+        uint32_t w = bit / 32, desp = bit % 32;
+        for (uint32_t c = 0; c < CARRILES; c++) {
+            uint32_t v = palabras[w * CARRILES + c] >> desp;
+            if (desp != 0 && desp + bits > 32) v |= palabras[(w + 1) * CARRILES + c] << (32 - desp);
+            out[k * CARRILES + c] = v & mascara;
+        }
+    }
+}
+
+inline void sumaPrefijaEscalar(uint32_t* valores, uint32_t n, uint32_t base) {
+    for (uint32_t i = 0; i < n; i++) {
+        base += valores[i];
+        valores[i] = base;
+    }
+}
+
+#ifdef COMPRESION_X86
+inline void desempacarSSE2(const uint32_t* palabras, uint32_t bits, uint32_t* out) {
+    const __m128i mascara = _mm_set1_epi32(bits == 32 ? -1 : static_cast<int>((1u << bits) - 1));
+    for (uint32_t k = 0; k < VALORES_POR_CARRIL; k++) {
+        uint32_t bit = k * bits;
+        uint32_t w = bit / 32, desp = bit % 32;
+        const __m128i cuenta = _mm_cvtsi32_si128(static_cast<int>(desp));
+        for (uint32_t mitad = 0; mitad < CARRILES; mitad += 4) {
+            __m128i v = _mm_srl_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(palabras + w * CARRILES + mitad)), cuenta);
+            if (desp != 0 && desp + bits > 32) {
+                __m128i sig = _mm_loadu_si128(reinterpret_cast<const __m128i*>(palabras + (w + 1) * CARRILES + mitad));
+                v = _mm_or_si128(v, _mm_sll_epi32(sig, _mm_cvtsi32_si128(static_cast<int>(32 - desp))));
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + k * CARRILES + mitad), _mm_and_si128(v, mascara));
+        }
+    }
+}
+
+inline void sumaPrefijaSSE2(uint32_t* valores, uint32_t base) {
+    __m128i acarreo = _mm_set1_epi32(static_cast<int>(base));
+    for (uint32_t i = 0; i < TAM_BLOQUE; i += 4) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(valores + i));
+        x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+        x = _mm_add_epi32(x, _mm_slli_si128(x, 8));
+        x = _mm_add_epi32(x, acarreo);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(valores + i), x);
+        acarreo = _mm_shuffle_epi32(x, 0xFF);
+    }
+}
+
+#if defined(__GNUC__)
+__attribute__((target("avx2")))
+inline void desempacarAVX2(const uint32_t* palabras, uint32_t bits, uint32_t* out) {
+    const __m256i mascara = _mm256_set1_epi32(bits == 32 ? -1 : static_cast<int>((1u << bits) - 1));
+    for (uint32_t k = 0; k < VALORES_POR_CARRIL; k++) {
+        uint32_t bit = k * bits;
+        uint32_t w = bit / 32, desp = bit % 32;
+        __m256i v = _mm256_srl_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(palabras + w * CARRILES)),
+                                     _mm_cvtsi32_si128(static_cast<int>(desp)));
+        if (desp != 0 && desp + bits > 32) {
+            __m256i sig = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(palabras + (w + 1) * CARRILES));
+            v = _mm256_or_si256(v, _mm256_sll_epi32(sig, _mm_cvtsi32_si128(static_cast<int>(32 - desp))));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + k * CARRILES), _mm256_and_si256(v, mascara));
+    }
+}
+
+__attribute__((target("avx2")))
+inline void sumaPrefijaAVX2(uint32_t* valores, uint32_t base) {
+    __m256i acarreo = _mm256_set1_epi32(static_cast<int>(base));
+    const __m256i ultimo = _mm256_set1_epi32(7);
+    for (uint32_t i = 0; i < TAM_BLOQUE; i += 8) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(valores + i));
+        x = _mm256_add_epi32(x, _mm256_slli_si256(x, 4));
+        x = _mm256_add_epi32(x, _mm256_slli_si256(x, 8));
+        // Suma la mitad baja acumulada a la mitad alta
+        __m256i bajo = _mm256_shuffle_epi32(x, 0xFF);
+        x = _mm256_add_epi32(x, _mm256_permute2x128_si256(bajo, bajo, 0x08));
+        x = _mm256_add_epi32(x, acarreo);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(valores + i), x);
+        acarreo = _mm256_permutevar8x32_epi32(x, ultimo);
+    }
+}
+#endif
+#endif
+
+// Nivel de SIMD usado para decodificar, elegido una vez segun la CPU
+enum NivelSIMD { ESCALAR, SSE2, AVX2 };
+
+inline NivelSIMD detectarSIMD() {
+#if defined(COMPRESION_X86) && defined(__GNUC__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return AVX2;
+    return SSE2;
+#elif defined(COMPRESION_X86)
+    return SSE2;
+#else
+    return ESCALAR;
+#endif
+}
+
+inline NivelSIMD& nivelSIMD() {
+    static NivelSIMD nivel = detectarSIMD();
+    return nivel;
+}
+
+inline const char* nombreSIMD(NivelSIMD nivel) {
+    switch (nivel) {
+        case AVX2: return "AVX2";
+        case SSE2: return "SSE2";
+        default: return "escalar";
+    }
+}
+
+inline void desempacar(const uint32_t* palabras, uint32_t bits, uint32_t* out) {
+    if (bits == 0) {
+        std::fill(out, out + TAM_BLOQUE, 0u);
+        return;
+    }
+    switch (nivelSIMD()) {
+#ifdef COMPRESION_X86
+#if defined(__GNUC__)
+        case AVX2: desempacarAVX2(palabras, bits, out); return;
+#endif
+        case SSE2: desempacarSSE2(palabras, bits, out); return;
+#endif
+        default: desempacarEscalar(palabras, bits, out); return;
+    }
+}
+
+inline void sumaPrefija(uint32_t* valores, uint32_t n, uint32_t base) {
+    if (n == TAM_BLOQUE) {
+        switch (nivelSIMD()) {
+#ifdef COMPRESION_X86
+#if defined(__GNUC__)
+            case AVX2: sumaPrefijaAVX2(valores, base); return;
+#endif
+            case SSE2: sumaPrefijaSSE2(valores, base); return;
+#endif
+            default: break;
+        }
+    }
+    sumaPrefijaEscalar(valores, n, base);
+}
+
+// ---------- bloques ----------
+
+// Codifica un bloque de hasta 128 postings. 'base' es el ultimo docID del bloque anterior
+// (0 para el primero); el primer gap se mide desde ahi.
+inline BloquePostings codificarBloque(const uint32_t* docIDs, const uint32_t* frecuencias, uint32_t n, uint32_t base, std::vector<uint8_t>& out) {
+    BloquePostings bloque;
+    std::memset(&bloque, 0, sizeof(bloque));
+    bloque.offset = out.size();
+    bloque.ultimoDocID = docIDs[n - 1];
+    bloque.cantidad = static_cast<uint8_t>(n);
+
+    uint32_t gaps[TAM_BLOQUE] = {0}, tfs[TAM_BLOQUE] = {0};
+    uint32_t maxGap = 0, maxTf = 0;
+    size_t bytesVar = 0;
+    uint32_t previo = base;
+    for (uint32_t i = 0; i < n; i++) {
+        gaps[i] = docIDs[i] - previo;
+        previo = docIDs[i];
+        tfs[i] = frecuencias[i] - 1;
+        maxGap = std::max(maxGap, gaps[i]);
+        maxTf = std::max(maxTf, tfs[i]);
+        bytesVar += bytesVarint(gaps[i]) + bytesVarint(tfs[i]);
+    }
+
+    bloque.maxTf = maxTf + 1;
+
+    uint32_t bitsDoc = bitsNecesarios(maxGap), bitsTf = bitsNecesarios(maxTf);
+    size_t bytesBit = 2 + (palabrasPorCarril(bitsDoc) + palabrasPorCarril(bitsTf)) * CARRILES * sizeof(uint32_t);
+    if (n == TAM_BLOQUE && bytesBit < bytesVar) {
+        bloque.codec = BITPACK;
+        out.push_back(static_cast<uint8_t>(bitsDoc));
+        empacar(gaps, bitsDoc, out);
+        bloque.bytesDocs = static_cast<uint16_t>(out.size() - bloque.offset);
+        out.push_back(static_cast<uint8_t>(bitsTf));
+        empacar(tfs, bitsTf, out);
+    } else {
+        bloque.codec = VARINT;
+        for (uint32_t i = 0; i < n; i++) escribirVarint(gaps[i], out);
+        bloque.bytesDocs = static_cast<uint16_t>(out.size() - bloque.offset);
+        for (uint32_t i = 0; i < n; i++) escribirVarint(tfs[i], out);
+    }
+    return bloque;
+}
+
+// Decodifica los docIDs de un bloque (hasta 128 valores en 'out')
+inline void decodificarDocIDs(const BloquePostings& bloque, const uint8_t* datos, uint32_t base, uint32_t* out) {
+    const uint8_t* p = datos + bloque.offset;
+    if (bloque.codec == BITPACK) {
+        uint32_t bits = p[0];
+        uint32_t palabras[TAM_BLOQUE];
+        std::memcpy(palabras, p + 1, palabrasPorCarril(bits) * CARRILES * sizeof(uint32_t));
+        desempacar(palabras, bits, out);
+    } else {
+        for (uint32_t i = 0; i < bloque.cantidad; i++) p = leerVarint(p, out[i]);
+    }
+    sumaPrefija(out, bloque.cantidad, base);
+}
+
+// Decodifica las frecuencias de un bloque
+inline void decodificarFrecuencias(const BloquePostings& bloque, const uint8_t* datos, uint32_t* out) {
+    const uint8_t* p = datos + bloque.offset + bloque.bytesDocs;
+    if (bloque.codec == BITPACK) {
+        uint32_t bits = p[0];
+        uint32_t palabras[TAM_BLOQUE];
+        std::memcpy(palabras, p + 1, palabrasPorCarril(bits) * CARRILES * sizeof(uint32_t));
+        desempacar(palabras, bits, out);
+    } else {
+        for (uint32_t i = 0; i < bloque.cantidad; i++) p = leerVarint(p, out[i]);
+    }
+    for (uint32_t i = 0; i < bloque.cantidad; i++) out[i] += 1;
+}
+
+} // namespace Compresion
+
+#endif // COMPRESION_H
@@ -1,28 +1,39 @@
 #ifndef DOCUMENT_H
 #define DOCUMENT_H
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include "Arreglo.h"
 
-class Document { //Hacer Key / nodos(lista enlazada) que guarde los documentos
+// Tabla de documentos: asigna un docID consecutivo a cada linea del corpus y guarda su URL una sola vez.
+// Las URLs van concatenadas en un solo bloque de texto; inicioUrl[d]..inicioUrl[d+1] delimita la del docID d.
+class TablaDocumentos {
 public:
-    std::string url; // Url del documento
-    Document *next = nullptr;
-    int frecuencia = 1; // Frecuencia iniciada en 1
-    
-    Document(std::string _url) : url(_url), next(nullptr), frecuencia(1) {}
+    Arreglo<uint64_t> inicioUrl;  // numDocs + 1 posiciones dentro de textoUrls
+    Arreglo<char> textoUrls;      // URLs concatenadas
+    Arreglo<uint32_t> longitudes; // docID -> terminos indexados (sin stopwords)
 
-    void setNext(Document* _next) {
-        next = _next;
+    TablaDocumentos() {
+        inicioUrl.push_back(0);
     }
 
-};
+    // Registra un documento nuevo y devuelve su docID
+    uint32_t agregar(std::string_view url, uint32_t longitud) {
+        textoUrls.agregar(url.data(), url.size());
+        inicioUrl.push_back(textoUrls.size());
+        longitudes.push_back(longitud);
+        return static_cast<uint32_t>(longitudes.size() - 1);
+    }
 
-class listaString {
-public:
-    std::string value;
-    listaString *next = nullptr;
+    std::string_view url(uint32_t docID) const {
+        return std::string_view(textoUrls.data() + inicioUrl[docID], inicioUrl[docID + 1] - inicioUrl[docID]);
+    }
 
-    listaString(std::string _value) : value(_value), next(nullptr) {}
+    uint32_t longitud(uint32_t docID) const {
+        return longitudes[docID];
+    }
 
+    size_t size() const { return longitudes.size(); }
 };
 
 #endif // DOCUMENT_H
@@ -0,0 +1,321 @@
+#ifndef EVALUACION_H
+#define EVALUACION_H
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Document.h"
+#include "Indice.h"
+#include "Interseccion.h"
+#include "Metricas.h"
+#include "Ranking.h"
+
+// Semantica de una consulta de varias palabras
+enum class ModoConsulta {
+    OR,  // documentos con al menos una palabra (union)
+    AND, // documentos con todas las palabras (interseccion)
+};
+
+inline const char* nombreModo(ModoConsulta modo) {
+    return modo == ModoConsulta::AND ? "and" : "or";
+}
+
+// Interpreta "and"/"or"; devuelve false si no es un modo valido
+inline bool leerModo(const std::string& texto, ModoConsulta& modo) {
+    if (texto == "and" || texto == "AND") { modo = ModoConsulta::AND; return true; }
+    if (texto == "or" || texto == "OR") { modo = ModoConsulta::OR; return true; }
+    return false;
+}
+
+// Consulta en forma canonica: palabras en minuscula, sin stopwords, sin repetir y ordenadas
+// (los dos modos ignoran el orden de las palabras). Textos con la misma forma canonica
+// tienen el mismo resultado, asi que comparten la clave de 64 bits en el cache.
+struct ConsultaNormalizada {
+    std::vector<std::string> terminos;
+    uint64_t clave = 0;
+};
+
+// Hash FNV-1a de 64 bits del modo y los terminos canonicos
+inline uint64_t claveConsulta(ModoConsulta modo, const std::vector<std::string>& terminos) {
+    uint64_t h = 0xcbf29ce484222325ull;
+    auto mezclar = [&h](unsigned char c) {
+        h ^= c;
+        h *= 0x100000001b3ull;
+    };
+    mezclar(static_cast<unsigned char>(modo));
+    for (const auto& termino : terminos) {
+        mezclar(0); // separador: "ab c" y "a bc" no colisionan
+        for (char c : termino) mezclar(static_cast<unsigned char>(c));
+    }
+    return h;
+}
+
+// Normaliza el texto de una consulta; 'esStopword' decide que palabras se descartan
+template <typename FiltroStopwords>
+ConsultaNormalizada normalizarConsulta(const std::string& texto, ModoConsulta modo, FiltroStopwords esStopword) {
+    ConsultaNormalizada consulta;
+    std::string palabra;
+    CronometroEtapa medirTokenizar(Etapa::TOKENIZAR);
+    for (size_t i = 0; i <= texto.size(); i++) {
+        unsigned char c = i < texto.size() ? static_cast<unsigned char>(texto[i]) : ' ';
+        if (!std::isspace(c)) {
+            palabra.push_back(static_cast<char>(std::tolower(c)));
+            continue;
+        }
+        if (!palabra.empty() && !esStopword(palabra)) consulta.terminos.push_back(palabra);
+        palabra.clear();
+    }
+    medirTokenizar.detener();
+    CronometroEtapa medirNormalizar(Etapa::NORMALIZAR);
+    std::sort(consulta.terminos.begin(), consulta.terminos.end());
+    consulta.terminos.erase(std::unique(consulta.terminos.begin(), consulta.terminos.end()), consulta.terminos.end());
+    consulta.clave = claveConsulta(modo, consulta.terminos);
+    return consulta;
+}
+
+// Documento de un resultado en formato compacto (8 bytes)
+struct DocResultado {
+    uint32_t docID;
+    float puntaje;
+};
+
+// Resultado estructurado de una consulta: es lo que guarda el cache y lo que usan
+// tanto el formateador de texto como el grafo de co-relevancia. Los puntajes se
+// guardan en float para que cada entrada del cache ocupe poco.
+struct ResultadoConsulta {
+    bool sinPalabras = false;       // la consulta no tenia palabras validas
+    std::vector<DocResultado> docs; // los k mejores, de mayor a menor puntaje
+
+    static ResultadoConsulta desde(const std::vector<DocPuntaje>& topk) {
+        ResultadoConsulta resultado;
+        resultado.docs.reserve(topk.size());
+        for (const auto& doc : topk) {
+            resultado.docs.push_back({doc.docID, static_cast<float>(doc.puntaje)});
+        }
+        return resultado;
+    }
+};
+
+// Memoria dinamica de un resultado (para la capacidad en bytes del cache)
+inline size_t bytesDinamicos(const ResultadoConsulta& resultado) {
+    return resultado.docs.capacity() * sizeof(DocResultado);
+}
+
+// Suma el puntaje BM25 de cada documento que contiene alguna palabra de la consulta
+inline std::unordered_map<uint32_t, double> acumularPuntajes(const Indice& indice, const BM25& bm25, const std::vector<std::string>& palabras) {
+    std::unordered_map<uint32_t, double> puntajes;
+    uint32_t numDocs = static_cast<uint32_t>(indice.numDocumentos());
+    double promedio = indice.longitudPromedio();
+    for (const std::string& palabra : palabras) {
+        CursorPostings cursor = indice.buscar(palabra);
+        if (cursor.size() == 0) continue;
+        double idf = bm25.idf(cursor.size(), numDocs);
+        for (; !cursor.fin(); cursor.siguiente()) {
+            uint32_t docID = cursor.docID();
+            puntajes[docID] += bm25.puntaje(cursor.frecuencia(), indice.longitud(docID), promedio, idf);
+        }
+    }
+    return puntajes;
+}
+
+// Selecciona los k documentos con mayor puntaje usando un heap de tamano k
+inline std::vector<DocPuntaje> seleccionarTopK(const std::unordered_map<uint32_t, double>& puntajes, size_t k) {
+    TopK topk(k);
+    for (const auto& par : puntajes) {
+        topk.agregar(par.first, par.second);
+    }
+    return topk.resultados();
+}
+
+// Cota superior del puntaje de un termino en cualquier documento del bloque
+inline double cotaBloque(const BM25& bm25, const Compresion::BloquePostings& bloque, double promedio, double idf) {
+    // el margen cubre diferencias de redondeo entre la cota y el puntaje real
+    return bm25.puntaje(bloque.maxTf, bloque.minLongitud, promedio, idf) * (1.0 + 1e-9);
+}
+
+// Puntaje estatico que se suma al de texto (fusion lineal): peso * valores[docID]. Los
+// valores tienen que ser no crecientes en docID (indice ordenado por puntaje estatico, ver
+// RankingEstatico.h): asi peso * valores[d] acota el aporte de todo documento desde d.
+// Sin valores no se suma nada.
+struct PriorEstatico {
+    const float* valores = nullptr;
+    double peso = 0.0;
+
+    double aporte(uint32_t docID) const {
+        return valores != nullptr ? peso * valores[docID] : 0.0;
+    }
+};
+
+// Termino de la consulta durante la evaluacion documento a documento
+struct TerminoConsulta {
+    CursorPostings cursor;
+    double idf;
+    double cota;  // cota del termino en toda su lista
+    size_t orden; // posicion en la consulta
+};
+
+// Top-k de la union (modo OR) con Block-Max WAND. Los cursores avanzan en orden de docID;
+// el pivote es el primer documento cuya suma de cotas puede superar al peor del heap, y
+// antes de decodificar se comprueba con las cotas de los bloques (maxTf, minLongitud)
+// si algun documento hasta el fin del bloque mas corto puede entrar. Como los documentos
+// se visitan en orden creciente y TopK desempata por el docID menor, basta con exigir
+// una cota estrictamente mayor al umbral: el resultado es el mismo que el exhaustivo.
+// Con un prior estatico su cota en el documento de cada cursor se suma a las de los
+// terminos; como decrece con el docID, el recorrido termina antes cuando los primeros
+// documentos (los de mayor puntaje estatico) ya llenaron el top-k.
+inline std::vector<DocPuntaje> evaluarDisyuncion(const Indice& indice, const BM25& bm25, const std::vector<std::string>& palabras, size_t k, const PriorEstatico& prior = PriorEstatico()) {
+    CronometroEtapa medirListas(Etapa::LISTAS);
+    uint32_t numDocs = static_cast<uint32_t>(indice.numDocumentos());
+    double promedio = indice.longitudPromedio();
+    std::vector<TerminoConsulta> terminos;
+    for (const std::string& palabra : palabras) {
+        int64_t termID = indice.buscarTermino(palabra);
+        if (termID < 0) continue;
+        CursorPostings cursor = indice.postingsDe(static_cast<uint32_t>(termID));
+        if (cursor.size() == 0) continue;
+        double idf = bm25.idf(cursor.size(), numDocs);
+        terminos.push_back(TerminoConsulta{cursor, idf, indice.cotaTermino(static_cast<uint32_t>(termID), bm25, idf), terminos.size()});
+    }
+    medirListas.detener();
+
+    CronometroEtapa medirRecorrido(Etapa::RECORRIDO);
+    const uint32_t FIN = UINT32_MAX;
+    auto docActual = [&](size_t t) { return terminos[t].cursor.fin() ? FIN : terminos[t].cursor.docID(); };
+    std::vector<size_t> vivos(terminos.size());
+    for (size_t t = 0; t < vivos.size(); t++) vivos[t] = t;
+    std::vector<double> contribucion(terminos.size());
+    TopK topk(k);
+
+    while (true) {
+        vivos.erase(std::remove_if(vivos.begin(), vivos.end(), [&](size_t t) { return terminos[t].cursor.fin(); }), vivos.end());
+        if (vivos.empty()) break;
+        std::sort(vivos.begin(), vivos.end(), [&](size_t a, size_t b) { return docActual(a) < docActual(b); });
+
+        bool lleno = topk.lleno();
+        double umbral = topk.umbral();
+        size_t n = vivos.size(), p = n;
+        double suma = 0.0;
+        for (size_t i = 0; i < n; i++) {
+            suma += terminos[vivos[i]].cota;
+            if (!lleno || suma + prior.aporte(docActual(vivos[i])) > umbral) { p = i; break; }
+        }
+        if (p == n) break; // ningun documento restante puede entrar al top-k
+        uint32_t pivote = docActual(vivos[p]);
+        while (p + 1 < n && docActual(vivos[p + 1]) == pivote) p++;
+
+        if (lleno) {
+            // Cota por bloques: vale para todos los documentos en [pivote, limite)
+            double sumaBloques = prior.aporte(pivote);
+            uint32_t limite = p + 1 < n ? docActual(vivos[p + 1]) : FIN;
+            for (size_t i = 0; i <= p; i++) {
+                TerminoConsulta& termino = terminos[vivos[i]];
+                uint32_t b = termino.cursor.bloqueDe(pivote);
+                if (b >= termino.cursor.cantidadBloques()) continue; // no tiene documentos desde el pivote
+                const Compresion::BloquePostings& bloque = termino.cursor.bloque(b);
+                sumaBloques += cotaBloque(bm25, bloque, promedio, termino.idf);
+                limite = std::min(limite, bloque.ultimoDocID + 1);
+            }
+            if (sumaBloques <= umbral) {
+                for (size_t i = 0; i <= p; i++) terminos[vivos[i]].cursor.avanzarHasta(limite);
+                continue;
+            }
+        }
+
+        if (docActual(vivos[0]) == pivote) {
+            // Se suma en el orden de la consulta para obtener exactamente el puntaje exhaustivo
+            std::fill(contribucion.begin(), contribucion.end(), 0.0);
+            uint32_t longitud = indice.longitud(pivote);
+            for (size_t i = 0; i <= p; i++) {
+                TerminoConsulta& termino = terminos[vivos[i]];
+                contribucion[termino.orden] = bm25.puntaje(termino.cursor.frecuencia(), longitud, promedio, termino.idf);
+                termino.cursor.siguiente();
+            }
+            double puntaje = 0.0;
+            for (double c : contribucion) puntaje += c;
+            topk.agregar(pivote, puntaje + prior.aporte(pivote));
+        } else {
+            // Ningun documento antes del pivote puede entrar: se saltan
+            for (size_t i = 0; i < p && docActual(vivos[i]) < pivote; i++) {
+                terminos[vivos[i]].cursor.avanzarHasta(pivote);
+            }
+        }
+    }
+    return topk.resultados();
+}
+
+// Documentos que contienen todas las palabras. Las listas se intersectan de la mas corta
+// a la mas larga: si la siguiente lista es mucho mas larga que los candidatos se galopa
+// sobre ella (saltando bloques comprimidos completos); si tienen tamanos parecidos se
+// decodifica y se intersecta con el kernel SIMD.
+inline std::vector<uint32_t> intersectarPalabras(const Indice& indice, const std::vector<std::string>& palabras) {
+    std::vector<CursorPostings> cursores;
+    std::vector<int64_t> vistos;
+    for (const std::string& palabra : palabras) {
+        int64_t termID = indice.buscarTermino(palabra);
+        if (termID < 0) return {}; // una palabra sin documentos vacia la interseccion
+        if (std::find(vistos.begin(), vistos.end(), termID) != vistos.end()) continue;
+        vistos.push_back(termID);
+        cursores.push_back(indice.postingsDe(static_cast<uint32_t>(termID)));
+    }
+    if (cursores.empty()) return {};
+    std::sort(cursores.begin(), cursores.end(), [](const CursorPostings& a, const CursorPostings& b) {
+        return a.size() < b.size();
+    });
+
+    std::vector<uint32_t> candidatos, siguiente, lista;
+    cursores[0].decodificarTodo(candidatos);
+    for (size_t t = 1; t < cursores.size() && !candidatos.empty(); t++) {
+        siguiente.clear();
+        CursorPostings& cursor = cursores[t];
+        if (cursor.size() > candidatos.size() * Interseccion::PROPORCION_GALOPE) {
+            for (uint32_t docID : candidatos) {
+                cursor.avanzarHasta(docID);
+                if (cursor.fin()) break;
+                if (cursor.docID() == docID) siguiente.push_back(docID);
+            }
+        } else {
+            lista.clear();
+            cursor.decodificarTodo(lista);
+            Interseccion::intersectar(candidatos, lista, siguiente);
+        }
+        candidatos.swap(siguiente);
+    }
+    return candidatos;
+}
+
+// Puntaje BM25 (mas el prior estatico, si hay) de los documentos de la interseccion (modo AND)
+inline std::vector<DocPuntaje> evaluarConjuncion(const Indice& indice, const BM25& bm25, const std::vector<std::string>& palabras, size_t k, const PriorEstatico& prior = PriorEstatico()) {
+    CronometroEtapa medirListas(Etapa::LISTAS);
+    std::vector<uint32_t> candidatos = intersectarPalabras(indice, palabras);
+    medirListas.detener();
+    if (candidatos.empty()) return {};
+    CronometroEtapa medirRecorrido(Etapa::RECORRIDO);
+    std::vector<double> puntajes(candidatos.size(), 0.0);
+    uint32_t numDocs = static_cast<uint32_t>(indice.numDocumentos());
+    double promedio = indice.longitudPromedio();
+    for (const std::string& palabra : palabras) {
+        CursorPostings cursor = indice.buscar(palabra);
+        double idf = bm25.idf(cursor.size(), numDocs);
+        for (size_t i = 0; i < candidatos.size(); i++) {
+            cursor.avanzarHasta(candidatos[i]);
+            puntajes[i] += bm25.puntaje(cursor.frecuencia(), indice.longitud(candidatos[i]), promedio, idf);
+        }
+    }
+    TopK topk(k);
+    for (size_t i = 0; i < candidatos.size(); i++) {
+        topk.agregar(candidatos[i], puntajes[i] + prior.aporte(candidatos[i]));
+    }
+    return topk.resultados();
+}
+
+// Evalua la consulta segun el modo y devuelve los k mejores documentos
+inline std::vector<DocPuntaje> evaluarConsulta(const Indice& indice, const BM25& bm25, const std::vector<std::string>& palabras, ModoConsulta modo, size_t k, const PriorEstatico& prior = PriorEstatico()) {
+    if (modo == ModoConsulta::AND) {
+        return evaluarConjuncion(indice, bm25, palabras, k, prior);
+    }
+    return evaluarDisyuncion(indice, bm25, palabras, k, prior);
+}
+
+#endif // EVALUACION_H
@@ -1,85 +1,624 @@
 #pragma once
-#include <map>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <deque>
 #include <vector>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <fstream>
+#include <functional>
 #include <iostream>
+#include "PoolHilos.h"
 
+// Forma de iterar PageRank
+enum class MetodoPageRank {
+    PUSH,         // cada nodo reparte su PR a sus vecinos (un solo hilo)
+    PULL,         // cada nodo junta los aportes de sus vecinos (Jacobi, en paralelo)
+    GAUSS_SEIDEL, // como PULL, pero usa los valores ya actualizados de su rango
+};
+
+inline const char* nombreMetodo(MetodoPageRank metodo) {
+    switch (metodo) {
+        case MetodoPageRank::PUSH: return "push";
+        case MetodoPageRank::GAUSS_SEIDEL: return "gs";
+        default: return "pull";
+    }
+}
+
+// Interpreta "push"/"pull"/"gs"; devuelve false si no es un metodo valido
+inline bool leerMetodoPageRank(const std::string& texto, MetodoPageRank& metodo) {
+    if (texto == "push") { metodo = MetodoPageRank::PUSH; return true; }
+    if (texto == "pull") { metodo = MetodoPageRank::PULL; return true; }
+    if (texto == "gs") { metodo = MetodoPageRank::GAUSS_SEIDEL; return true; }
+    return false;
+}
+
+// Parametros de PageRank
+struct OpcionesPageRank {
+    double d = 0.85;            // factor de amortiguacion
+    int maxIteraciones = 100;
+    double tolerancia = 1e-9;   // se detiene cuando el residuo L1 baja de este valor
+    bool ponderado = false;     // transiciones proporcionales al peso de la arista
+    MetodoPageRank metodo = MetodoPageRank::PULL;
+};
+
+// PageRank por id de nodo, con las iteraciones usadas y el residuo L1 de la ultima
+struct ResultadoPageRank {
+    std::vector<double> valores;
+    int iteraciones = 0;
+    double residuo = 0.0;
+};
+
+// Grafo de co-relevancia no dirigido y con pesos, en dos fases.
+// Construccion: cada URL recibe un id entero la primera vez que aparece y las aristas
+// nuevas se acumulan en un buffer agregado por hash (una entrada por par no dirigido,
+// con su peso), sin recorrer listas de vecinos. finalizar() compacta el buffer en arreglos
+// CSR: los vecinos de u son vecinos[desplazamientos[u] .. finVecinos(u)) con su peso en
+// 'pesos', en el orden en que aparecio cada arista. Se puede seguir agregando despues de
+// finalizar; la siguiente llamada fusiona lo nuevo con lo que ya habia. Con 'holgura' cada
+// nodo reserva espacio libre hasta desplazamientos[u + 1], asi los lotes chicos (las
+// consultas de la interfaz) se escriben en su lugar sin reconstruir el CSR.
+// Para muchas aristas de una vez, agregarLote() recibe los pares como claves de 64 bits y
+// los agrega con radix sort en lugar del hash.
+// Las consultas (vecinos, grados, PageRank, exportacion) ven solo la parte finalizada.
 class Grafo {
 public:
-    // Lista de adyacencia: nodo origen -> vector de (nodo destino, peso)
-    std::map<std::string, std::vector<std::pair<std::string, int>>> adj;
+    static constexpr uint32_t SIN_NODO = UINT32_MAX;
 
-    // Agrega una arista no dirigida (ambos sentidos)
-    void agregarAristaNoDirigida(const std::string& a, const std::string& b) {
-        agregarAristaSimple(a, b);
-        agregarAristaSimple(b, a);
-    }
+    // Las claves de 'ids' apuntan a las URLs de este grafo: una copia quedaria apuntando a
+    // las del original. Mover si se puede, porque el deque conserva sus elementos.
+    Grafo() = default;
+    Grafo(const Grafo&) = delete;
+    Grafo& operator=(const Grafo&) = delete;
+    Grafo(Grafo&&) = default;
+    Grafo& operator=(Grafo&&) = default;
+
+    // CSR de la parte finalizada
+    std::vector<uint64_t> desplazamientos; // numNodosFinalizados + 1 entradas, inicio del espacio de cada nodo
+    std::vector<uint32_t> grados;          // vecinos ocupados del espacio de cada nodo
+    std::vector<uint32_t> vecinos;
+    std::vector<uint32_t> pesos;
+
+    // Espacio libre por nodo al reconstruir el CSR, como fraccion del grado (0: compacto)
+    double holgura = 0.0;
+    static constexpr uint32_t HOLGURA_MINIMA = 8;
 
 private:
-    // Agrega una arista simple de a hacia b o incrementa su peso si ya existe
-    void agregarAristaSimple(const std::string& origen, const std::string& destino) {
-        for (auto& par : adj[origen]) {
-            if (par.first == destino) {
-                par.second++; // Incrementa el peso si ya existe
-                return;
+    std::deque<std::string> urls;                       // id -> URL (direcciones estables)
+    std::unordered_map<std::string_view, uint32_t> ids; // URL -> id, con vistas sobre 'urls'
+
+    // Arista no dirigida pendiente, con el peso acumulado desde el ultimo finalizar
+    struct AristaPendiente {
+        uint32_t a;
+        uint32_t b;
+        uint32_t peso;
+    };
+    std::vector<AristaPendiente> pendientes;              // en orden de aparicion
+    std::unordered_map<uint64_t, uint32_t> indicePendiente; // clave del par -> posicion
+    uint64_t vecinosOcupados = 0;                           // suma de los grados
+
+    // Espacio para un nodo con 'grado' vecinos
+    uint64_t capacidadPara(uint64_t grado) const {
+        return holgura > 0 ? grado + static_cast<uint64_t>(grado * holgura) + HOLGURA_MINIMA : grado;
+    }
+
+    // Escribe una arista nueva en el espacio libre de sus extremos (un lazo ocupa uno solo)
+    void escribirArista(const AristaPendiente& p) {
+        if (p.a == p.b) {
+            vecinos[desplazamientos[p.a] + grados[p.a]] = p.a;
+            pesos[desplazamientos[p.a] + grados[p.a]++] = 2 * p.peso;
+            vecinosOcupados++;
+            return;
+        }
+        vecinos[desplazamientos[p.a] + grados[p.a]] = p.b;
+        pesos[desplazamientos[p.a] + grados[p.a]++] = p.peso;
+        vecinos[desplazamientos[p.b] + grados[p.b]] = p.a;
+        pesos[desplazamientos[p.b] + grados[p.b]++] = p.peso;
+        vecinosOcupados += 2;
+    }
+
+    static uint64_t claveArista(uint32_t a, uint32_t b) {
+        if (a > b) std::swap(a, b);
+        return (static_cast<uint64_t>(a) << 32) | b;
+    }
+
+    // Ordena las claves (y sus posiciones) de forma estable con radix sort LSD de 11 bits por
+    // pasada, solo sobre los bits que usa la clave mayor
+    static void ordenarRadix(std::vector<uint64_t>& claves, std::vector<uint32_t>& posiciones) {
+        size_t m = claves.size();
+        uint64_t maxima = 0;
+        for (uint64_t clave : claves) maxima = std::max(maxima, clave);
+        std::vector<uint64_t> clavesAux(m);
+        std::vector<uint32_t> posicionesAux(m);
+        const int BITS = 11;
+        const uint64_t MASCARA = (uint64_t(1) << BITS) - 1;
+        std::vector<size_t> conteo(MASCARA + 2);
+        for (int corrimiento = 0; corrimiento < 64 && (maxima >> corrimiento) != 0; corrimiento += BITS) {
+            std::fill(conteo.begin(), conteo.end(), 0);
+            for (uint64_t clave : claves) conteo[((clave >> corrimiento) & MASCARA) + 1]++;
+            for (uint64_t digito = 0; digito <= MASCARA; digito++) conteo[digito + 1] += conteo[digito];
+            for (size_t i = 0; i < m; i++) {
+                size_t destino = conteo[(claves[i] >> corrimiento) & MASCARA]++;
+                clavesAux[destino] = claves[i];
+                posicionesAux[destino] = posiciones[i];
+            }
+            claves.swap(clavesAux);
+            posiciones.swap(posicionesAux);
+        }
+    }
+
+    // Peso total de salida de cada nodo: grado, o suma de pesos si se pondera
+    std::vector<double> pesosSalida(bool ponderado) const {
+        size_t N = numNodos();
+        std::vector<double> salida(N);
+        for (uint32_t u = 0; u < N; u++) {
+            if (!ponderado) {
+                salida[u] = grado(u);
+                continue;
+            }
+            uint64_t suma = 0;
+            for (uint64_t e = desplazamientos[u]; e < finVecinos(u); e++) suma += pesos[e];
+            salida[u] = static_cast<double>(suma);
+        }
+        return salida;
+    }
+
+    // Rangos contiguos de nodos destino con unas 'tamano' aristas (o nodos) cada uno.
+    // No dependen de la cantidad de hilos, asi que el resultado tampoco.
+    std::vector<uint32_t> rangosDeNodos(uint64_t tamano) const {
+        std::vector<uint32_t> limites{0};
+        uint32_t N = static_cast<uint32_t>(numNodos());
+        for (uint32_t v = 0; v < N; v++) {
+            uint32_t ini = limites.back();
+            if (desplazamientos[v + 1] - desplazamientos[ini] >= tamano || v + 1 - ini >= tamano) limites.push_back(v + 1);
+        }
+        if (limites.back() != N) limites.push_back(N);
+        return limites;
+    }
+
+    // Suma de los aportes de los vecinos de v. Como el grafo es no dirigido, el CSR es su
+    // propia transpuesta: los vecinos de v son tambien los nodos que apuntan a v.
+    // Cuatro acumuladores cortan la dependencia entre sumas y dejan vectorizar el gather.
+    template <bool PONDERADO>
+    double sumaAportes(uint32_t v, const double* aporte) const {
+        const uint32_t* vec = vecinos.data();
+        const uint32_t* pes = pesos.data();
+        uint64_t e = desplazamientos[v];
+        uint64_t fin = finVecinos(v);
+        double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+        for (; e + 4 <= fin; e += 4) {
+            s0 += PONDERADO ? aporte[vec[e]] * pes[e] : aporte[vec[e]];
+            s1 += PONDERADO ? aporte[vec[e + 1]] * pes[e + 1] : aporte[vec[e + 1]];
+            s2 += PONDERADO ? aporte[vec[e + 2]] * pes[e + 2] : aporte[vec[e + 2]];
+            s3 += PONDERADO ? aporte[vec[e + 3]] * pes[e + 3] : aporte[vec[e + 3]];
+        }
+        for (; e < fin; e++) s0 += PONDERADO ? aporte[vec[e]] * pes[e] : aporte[vec[e]];
+        return (s0 + s1) + (s2 + s3);
+    }
+
+    // Variante Gauss-Seidel: los vecinos de [ini, v) ya tienen su aporte de esta iteracion
+    template <bool PONDERADO>
+    double sumaAportesGS(uint32_t v, uint32_t ini, const double* aporte, const double* aporteNuevo) const {
+        double suma = 0.0;
+        for (uint64_t e = desplazamientos[v]; e < finVecinos(v); e++) {
+            uint32_t u = vecinos[e];
+            double a = (u >= ini && u < v) ? aporteNuevo[u] : aporte[u];
+            suma += PONDERADO ? a * pesos[e] : a;
+        }
+        return suma;
+    }
+
+    // PageRank pull sobre rangos de nodos destino. Cada rango escribe solo sus nodos (PR
+    // nuevo, aporte d * PR / salida para la siguiente iteracion y sus sumas parciales de
+    // residuo y masa colgante), asi que no hacen falta atomicos: el fin de cada
+    // pool.ejecutar es la barrera entre iteraciones.
+    template <bool PONDERADO>
+    ResultadoPageRank pageRankPull(const OpcionesPageRank& opciones, PoolHilos* pool) const {
+        const size_t TAM_RANGO = 1 << 14;
+        ResultadoPageRank resultado;
+        size_t N = numNodos();
+        const double d = opciones.d;
+        const bool gaussSeidel = opciones.metodo == MetodoPageRank::GAUSS_SEIDEL;
+        std::vector<double> salida = pesosSalida(PONDERADO);
+        std::vector<double>& pr = resultado.valores;
+        pr.assign(N, 1.0 / N);
+        std::vector<double> prNuevo(N);
+        std::vector<double> aporte(N);
+        std::vector<double> aporteNuevo(N);
+        double colgante = 0.0;
+        for (uint32_t u = 0; u < N; u++) {
+            if (salida[u] == 0) colgante += pr[u];
+            aporte[u] = salida[u] == 0 ? 0.0 : d * pr[u] / salida[u];
+        }
+
+        std::vector<uint32_t> limites = rangosDeNodos(TAM_RANGO);
+        size_t numRangos = limites.size() - 1;
+        std::vector<double> residuoRango(numRangos);
+        std::vector<double> colganteRango(numRangos);
+        std::vector<double> masaRango(numRangos);
+        double base = 0.0;
+        double escala = 1.0;
+        auto procesarRango = [&](size_t r) {
+            uint32_t ini = limites[r];
+            uint32_t fin = limites[r + 1];
+            double residuo = 0.0;
+            double colg = 0.0;
+            double masa = 0.0;
+            for (uint32_t v = ini; v < fin; v++) {
+                double suma = gaussSeidel ? sumaAportesGS<PONDERADO>(v, ini, aporte.data(), aporteNuevo.data())
+                                          : sumaAportes<PONDERADO>(v, aporte.data());
+                double valor = base + suma;
+                residuo += std::fabs(valor - pr[v]);
+                masa += valor;
+                prNuevo[v] = valor;
+                if (salida[v] == 0) {
+                    colg += valor;
+                    aporteNuevo[v] = 0.0;
+                } else {
+                    aporteNuevo[v] = d * valor / salida[v];
+                }
             }
+            residuoRango[r] = residuo;
+            colganteRango[r] = colg;
+            masaRango[r] = masa;
+        };
+        // Gauss-Seidel no conserva la masa total; sin reescalar, el error en esa direccion
+        // solo baja un factor d por iteracion y pierde la ventaja sobre Jacobi
+        auto normalizarRango = [&](size_t r) {
+            double residuo = 0.0;
+            for (uint32_t v = limites[r]; v < limites[r + 1]; v++) {
+                prNuevo[v] *= escala;
+                aporteNuevo[v] *= escala;
+                residuo += std::fabs(prNuevo[v] - pr[v]);
+            }
+            residuoRango[r] = residuo;
+        };
+        auto ejecutar = [&](const std::function<void(size_t)>& tarea) {
+            if (pool != nullptr) {
+                pool->ejecutar(numRangos, tarea);
+            } else {
+                for (size_t r = 0; r < numRangos; r++) tarea(r);
+            }
+        };
+
+        while (resultado.iteraciones < opciones.maxIteraciones) {
+            base = (1.0 - d) / N + d * colgante / N;
+            ejecutar(procesarRango);
+            colgante = 0.0;
+            double masa = 0.0;
+            for (size_t r = 0; r < numRangos; r++) {
+                colgante += colganteRango[r];
+                masa += masaRango[r];
+            }
+            if (gaussSeidel && masa > 0) {
+                escala = 1.0 / masa;
+                colgante *= escala;
+                ejecutar(normalizarRango);
+            }
+            resultado.residuo = 0.0;
+            for (size_t r = 0; r < numRangos; r++) resultado.residuo += residuoRango[r];
+            pr.swap(prNuevo);
+            aporte.swap(aporteNuevo);
+            resultado.iteraciones++;
+            if (resultado.residuo < opciones.tolerancia) break;
         }
-        adj[origen].push_back({destino, 1}); // Nueva arista con peso 1
+        return resultado;
     }
 
 public:
-    // Guarda el grafo en un archivo como lista de adyacencia
+    // Id del nodo de la URL; lo crea si no existe
+    uint32_t nodo(std::string_view url) {
+        auto it = ids.find(url);
+        if (it != ids.end()) return it->second;
+        uint32_t id = static_cast<uint32_t>(urls.size());
+        urls.emplace_back(url);
+        ids.emplace(std::string_view(urls.back()), id);
+        return id;
+    }
+
+    // Id del nodo de la URL, o SIN_NODO si no esta en el grafo
+    uint32_t buscarNodo(std::string_view url) const {
+        auto it = ids.find(url);
+        return it == ids.end() ? SIN_NODO : it->second;
+    }
+
+    const std::string& url(uint32_t id) const {
+        return urls[id];
+    }
+
+    // Agrega una arista no dirigida (ambos sentidos) o incrementa su peso si ya existe
+    void agregarAristaNoDirigida(uint32_t a, uint32_t b) {
+        auto res = indicePendiente.emplace(claveArista(a, b), static_cast<uint32_t>(pendientes.size()));
+        if (res.second) {
+            pendientes.push_back({a, b, 1});
+        } else {
+            pendientes[res.first->second].peso++;
+        }
+    }
+
+    void agregarAristaNoDirigida(const std::string& a, const std::string& b) {
+        agregarAristaNoDirigida(nodo(a), nodo(b));
+    }
+
+    // Agrega de una vez un lote de aristas no dirigidas entre nodos ya creados con nodo(),
+    // cada una como clave (a << 32) | b y en orden de aparicion; una clave repetida suma 1
+    // al peso. En lugar de pasar cada par por el hash del buffer, el lote se ordena con
+    // radix sort para juntar los pares iguales y sumarlos, y se carga en el CSR en el orden
+    // de la primera aparicion de cada par: queda igual que agregandolos uno por uno.
+    void agregarLote(const std::vector<uint64_t>& lote) {
+        if (!pendientes.empty()) finalizar();
+        uint64_t n = urls.size();
+        size_t m = lote.size();
+        std::vector<uint64_t> claves(m);
+        std::vector<uint32_t> posiciones(m);
+        for (size_t i = 0; i < m; i++) {
+            uint64_t a = lote[i] >> 32, b = lote[i] & 0xFFFFFFFFull;
+            claves[i] = a < b ? a * n + b : b * n + a; // par no dirigido en [0, n^2)
+            posiciones[i] = static_cast<uint32_t>(i);
+        }
+        ordenarRadix(claves, posiciones);
+
+        // El peso de cada par se anota en su primera aparicion (la primera del grupo, porque
+        // el orden es estable) y los pares pasan al buffer en ese orden
+        std::vector<uint32_t> pesoEn(m, 0);
+        for (size_t i = 0; i < m;) {
+            size_t j = i;
+            while (j < m && claves[j] == claves[i]) j++;
+            pesoEn[posiciones[i]] = static_cast<uint32_t>(j - i);
+            i = j;
+        }
+        for (size_t i = 0; i < m; i++) {
+            if (pesoEn[i] == 0) continue;
+            pendientes.push_back({static_cast<uint32_t>(lote[i] >> 32), static_cast<uint32_t>(lote[i]), pesoEn[i]});
+        }
+        finalizar();
+    }
+
+    // Compacta las aristas pendientes en los arreglos CSR. Las aristas que ya existian
+    // suman su peso en su lugar; las nuevas van despues de los vecinos anteriores de cada nodo.
+    // Si solo cambian pesos no se reconstruye nada, y con pocas aristas pendientes se
+    // buscan en los vecinos de sus extremos en lugar de recorrer todo el CSR.
+    void finalizar() {
+        size_t n = urls.size();
+        size_t nAnterior = numNodos();
+        if (pendientes.empty() && nAnterior == n) return;
+
+        // Aristas del buffer que ya estaban en el CSR
+        std::vector<bool> existente(pendientes.size(), false);
+        size_t nuevas = pendientes.size();
+        auto sumarPeso = [&](uint64_t e, size_t i) {
+            const AristaPendiente& p = pendientes[i];
+            pesos[e] += p.a == p.b ? 2 * p.peso : p.peso; // un lazo suma en los dos sentidos
+            if (!existente[i]) nuevas--;
+            existente[i] = true;
+        };
+        if (pendientes.size() * 16 < vecinos.size()) {
+            for (size_t i = 0; i < pendientes.size(); i++) {
+                uint32_t a = pendientes[i].a;
+                uint32_t b = pendientes[i].b;
+                if (a >= nAnterior || b >= nAnterior) continue;
+                for (uint64_t e = desplazamientos[a]; e < finVecinos(a); e++) {
+                    if (vecinos[e] == b) sumarPeso(e, i);
+                }
+                for (uint64_t e = desplazamientos[b]; e < finVecinos(b) && a != b; e++) {
+                    if (vecinos[e] == a) sumarPeso(e, i);
+                }
+            }
+        } else {
+            // Los lotes de agregarLote llegan sin indice: se arma si hay aristas anteriores
+            if (!vecinos.empty() && indicePendiente.size() != pendientes.size()) {
+                indicePendiente.clear();
+                for (size_t i = 0; i < pendientes.size(); i++) {
+                    indicePendiente.emplace(claveArista(pendientes[i].a, pendientes[i].b), static_cast<uint32_t>(i));
+                }
+            }
+            for (uint32_t u = 0; u < nAnterior && !pendientes.empty(); u++) {
+                for (uint64_t e = desplazamientos[u]; e < finVecinos(u); e++) {
+                    auto it = indicePendiente.find(claveArista(u, vecinos[e]));
+                    if (it != indicePendiente.end()) sumarPeso(e, it->second);
+                }
+            }
+        }
+        if (nuevas == 0 && nAnterior == n) {
+            std::vector<AristaPendiente>().swap(pendientes);
+            std::unordered_map<uint64_t, uint32_t>().swap(indicePendiente);
+            return;
+        }
+
+        // Aristas nuevas por nodo. Si entran en el espacio libre de los nodos anteriores se
+        // escriben en su lugar y los nodos nuevos se agregan al final, sin copiar el resto
+        std::vector<uint64_t> faltan;
+        bool caben = !vecinos.empty() && pendientes.size() * 16 < vecinos.size();
+        std::unordered_map<uint32_t, uint32_t> faltanAnteriores;
+        if (caben) {
+            faltan.assign(n - nAnterior, 0);
+            auto contar = [&](uint32_t u) {
+                if (u >= nAnterior) faltan[u - nAnterior]++;
+                else faltanAnteriores[u]++;
+            };
+            for (size_t i = 0; i < pendientes.size(); i++) {
+                if (existente[i]) continue;
+                contar(pendientes[i].a);
+                if (pendientes[i].a != pendientes[i].b) contar(pendientes[i].b);
+            }
+            for (const auto& par : faltanAnteriores) {
+                if (grados[par.first] + par.second > desplazamientos[par.first + 1] - desplazamientos[par.first]) caben = false;
+            }
+        }
+        if (caben) {
+            for (size_t u = nAnterior; u < n; u++) {
+                desplazamientos.push_back(desplazamientos.back() + capacidadPara(faltan[u - nAnterior]));
+                grados.push_back(0);
+            }
+            vecinos.resize(desplazamientos.back());
+            pesos.resize(desplazamientos.back());
+            for (size_t i = 0; i < pendientes.size(); i++) {
+                if (!existente[i]) escribirArista(pendientes[i]);
+            }
+            std::vector<AristaPendiente>().swap(pendientes);
+            std::unordered_map<uint64_t, uint32_t>().swap(indicePendiente);
+            return;
+        }
+
+        // Reconstruccion: cada nodo recibe su grado final mas la holgura
+        std::vector<uint64_t> nuevos(n + 1, 0);
+        std::vector<uint32_t> nuevosGrados(n, 0);
+        for (uint32_t u = 0; u < nAnterior; u++) nuevosGrados[u] = grados[u];
+        for (size_t i = 0; i < pendientes.size(); i++) {
+            if (existente[i]) continue;
+            nuevosGrados[pendientes[i].a]++;
+            if (pendientes[i].a != pendientes[i].b) nuevosGrados[pendientes[i].b]++;
+        }
+        for (size_t u = 0; u < n; u++) nuevos[u + 1] = nuevos[u] + capacidadPara(nuevosGrados[u]);
+
+        std::vector<uint32_t> nuevosVecinos(nuevos[n]);
+        std::vector<uint32_t> nuevosPesos(nuevos[n]);
+        for (uint32_t u = 0; u < nAnterior; u++) {
+            std::copy(vecinos.begin() + desplazamientos[u], vecinos.begin() + finVecinos(u), nuevosVecinos.begin() + nuevos[u]);
+            std::copy(pesos.begin() + desplazamientos[u], pesos.begin() + finVecinos(u), nuevosPesos.begin() + nuevos[u]);
+        }
+        desplazamientos.swap(nuevos);
+        vecinos.swap(nuevosVecinos);
+        pesos.swap(nuevosPesos);
+        grados.resize(n, 0);
+        for (size_t i = 0; i < pendientes.size(); i++) {
+            if (!existente[i]) escribirArista(pendientes[i]);
+        }
+        std::vector<AristaPendiente>().swap(pendientes);
+        std::unordered_map<uint64_t, uint32_t>().swap(indicePendiente);
+    }
+
+    // Reemplaza la parte finalizada por arreglos CSR compactos (por ejemplo, los de un
+    // snapshot); los nodos ya tienen que existir con nodo()
+    void asignarCSR(std::vector<uint64_t>&& _desplazamientos, std::vector<uint32_t>&& _vecinos, std::vector<uint32_t>&& _pesos) {
+        desplazamientos = std::move(_desplazamientos);
+        vecinos = std::move(_vecinos);
+        pesos = std::move(_pesos);
+        grados.assign(numNodos(), 0);
+        for (uint32_t u = 0; u < grados.size(); u++) grados[u] = static_cast<uint32_t>(desplazamientos[u + 1] - desplazamientos[u]);
+        vecinosOcupados = vecinos.size();
+    }
+
+    // Copia de la parte finalizada sin el espacio libre
+    void copiarCompacto(std::vector<uint64_t>& _desplazamientos, std::vector<uint32_t>& _vecinos, std::vector<uint32_t>& _pesos) const {
+        size_t N = numNodos();
+        _desplazamientos.assign(N + 1, 0);
+        _vecinos.clear();
+        _pesos.clear();
+        _vecinos.reserve(vecinosOcupados);
+        _pesos.reserve(vecinosOcupados);
+        for (uint32_t u = 0; u < N; u++) {
+            _vecinos.insert(_vecinos.end(), vecinos.begin() + desplazamientos[u], vecinos.begin() + finVecinos(u));
+            _pesos.insert(_pesos.end(), pesos.begin() + desplazamientos[u], pesos.begin() + finVecinos(u));
+            _desplazamientos[u + 1] = _vecinos.size();
+        }
+    }
+
+    // true si el CSR no tiene espacio libre
+    bool compacto() const {
+        return vecinosOcupados == vecinos.size();
+    }
+
+    // Nodos de la parte finalizada
+    size_t numNodos() const {
+        return desplazamientos.empty() ? 0 : desplazamientos.size() - 1;
+    }
+
+    // Aristas no dirigidas de la parte finalizada
+    size_t numAristas() const {
+        return vecinosOcupados / 2;
+    }
+
+    uint32_t grado(uint32_t u) const {
+        return grados[u];
+    }
+
+    // Fin de los vecinos ocupados de u
+    uint64_t finVecinos(uint32_t u) const {
+        return desplazamientos[u] + grados[u];
+    }
+
+    // Ids de los nodos ordenados por URL
+    std::vector<uint32_t> nodosPorUrl() const {
+        std::vector<uint32_t> orden(numNodos());
+        for (uint32_t u = 0; u < orden.size(); u++) orden[u] = u;
+        std::sort(orden.begin(), orden.end(), [&](uint32_t a, uint32_t b) { return urls[a] < urls[b]; });
+        return orden;
+    }
+
+    // Guarda el grafo en un archivo como lista de adyacencia (nodos ordenados por URL).
+    // El texto se arma en un buffer que se escribe de a bloques, sin vaciar por linea.
     void guardarEnArchivo(const std::string& filename) const {
         std::ofstream out(filename);
         if (!out.is_open()) {
             std::cerr << "No se pudo crear " << filename << std::endl;
             return;
         }
-        for (const auto& nodo : adj) {
-            out << "[" << nodo.first << "] -> ";
-            for (const auto& vecino : nodo.second) {
-                out << "[" << vecino.first << "~> peso: " << vecino.second << "] ";
+        const size_t TAM_BUFFER = size_t(1) << 20;
+        std::string buffer;
+        buffer.reserve(TAM_BUFFER + 4096);
+        for (uint32_t u : nodosPorUrl()) {
+            buffer.append("[").append(urls[u]).append("] -> ");
+            for (uint64_t e = desplazamientos[u]; e < finVecinos(u); e++) {
+                buffer.append("[").append(urls[vecinos[e]]).append("~> peso: ").append(std::to_string(pesos[e])).append("] ");
+                if (buffer.size() >= TAM_BUFFER) {
+                    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                    buffer.clear();
+                }
             }
-            out << std::endl;
+            buffer.push_back('\n');
         }
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
         out.close();
     }
 
-    // Calcula el PageRank de cada nodo usando el grado de salida
-    std::map<std::string, double> calcularPageRank(int iteraciones = 20, double d = 0.85) const {
-        std::map<std::string, double> pagerank;
-        std::vector<std::string> nodos;
-        for (const auto& par : adj) {
-            nodos.push_back(par.first);
-        }
-        int N = nodos.size();
-        if (N == 0) return pagerank;
-        double pr_inicial = 1.0 / N;
-        for (const auto& nodo : nodos) {
-            pagerank[nodo] = pr_inicial;
-        }
-        for (int it = 0; it < iteraciones; ++it) {
-            std::map<std::string, double> nuevoPR;
-            for (const auto& nodo : nodos) {
-                nuevoPR[nodo] = (1.0 - d) / N;
-            }
-            for (const auto& nodo : nodos) {
-                double pr = pagerank[nodo];
-                int out_degree = adj.at(nodo).size();
-                if (out_degree == 0) {
-                    // Nodo sin salidas: distribuye su PR a todos
-                    for (const auto& destino : nodos) {
-                        nuevoPR[destino] += d * pr / N;
+    // Calcula el PageRank de la parte finalizada, por id de nodo.
+    // Itera hasta que el residuo L1 entre dos iteraciones baja de la tolerancia (o se llega
+    // al maximo). La masa de los nodos sin salidas se reparte como un solo escalar sumado a
+    // la base de todos los nodos, en lugar de recorrer el grafo por cada uno.
+    // PULL y GAUSS_SEIDEL reparten los rangos de nodos entre los hilos del pool (si hay).
+    ResultadoPageRank calcularPageRank(const OpcionesPageRank& opciones = OpcionesPageRank(), PoolHilos* pool = nullptr) const {
+        if (numNodos() == 0) return ResultadoPageRank();
+        if (opciones.metodo != MetodoPageRank::PUSH) {
+            return opciones.ponderado ? pageRankPull<true>(opciones, pool) : pageRankPull<false>(opciones, pool);
+        }
+
+        ResultadoPageRank resultado;
+        size_t N = numNodos();
+        const double d = opciones.d;
+        std::vector<double> salida = pesosSalida(opciones.ponderado);
+
+        std::vector<double>& pr = resultado.valores;
+        pr.assign(N, 1.0 / N);
+        std::vector<double> nuevoPR(N);
+        resultado.residuo = 0.0;
+        while (resultado.iteraciones < opciones.maxIteraciones) {
+            double colgante = 0.0;
+            for (uint32_t u = 0; u < N; u++) {
+                if (salida[u] == 0) colgante += pr[u];
+            }
+            std::fill(nuevoPR.begin(), nuevoPR.end(), (1.0 - d) / N + d * colgante / N);
+            for (uint32_t u = 0; u < N; u++) {
+                if (salida[u] == 0) continue;
+                double aporte = d * pr[u] / salida[u];
+                if (opciones.ponderado) {
+                    for (uint64_t e = desplazamientos[u]; e < finVecinos(u); e++) {
+                        nuevoPR[vecinos[e]] += aporte * pesos[e];
                     }
                 } else {
-                    for (const auto& vecino : adj.at(nodo)) {
-                        nuevoPR[vecino.first] += d * pr / out_degree;
+                    for (uint64_t e = desplazamientos[u]; e < finVecinos(u); e++) {
+                        nuevoPR[vecinos[e]] += aporte;
                     }
                 }
             }
-            pagerank = nuevoPR;
+            resultado.residuo = 0.0;
+            for (uint32_t u = 0; u < N; u++) resultado.residuo += std::fabs(nuevoPR[u] - pr[u]);
+            pr.swap(nuevoPR);
+            resultado.iteraciones++;
+            if (resultado.residuo < opciones.tolerancia) break;
         }
-        return pagerank;
+        return resultado;
     }
 };
@@ -0,0 +1,91 @@
+#ifndef INDEXADOR_H
+#define INDEXADOR_H
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "Indice.h"
+#include "Stopwords.h"
+#include "Tokenizador.h"
+
+// Estadisticas de la carga del corpus
+struct EstadisticasCarga {
+    size_t bytes = 0;
+    double ms = 0.0;
+
+    double mbPorSegundo() const {
+        return ms > 0 ? (bytes / (1024.0 * 1024.0)) / (ms / 1000.0) : 0.0;
+    }
+};
+
+// Indexa un rango de lineas del corpus mapeado, un docID por linea no vacia
+inline void indexarRango(std::string_view texto, Indice& indice, const Stopwords& sw) {
+    std::string buffer; // se reutiliza para pasar cada termino a minusculas
+    std::string url;
+    Tokenizador::recorrerLineas(texto, [&](std::string_view linea) {
+        uint32_t docID = indice.siguienteDocID();
+        uint32_t longitud = 0;
+        url.clear();
+        Tokenizador::tokenizarLinea(linea, buffer,
+            [&](std::string_view segmento) { url.append(segmento.data(), segmento.size()); },
+            [&](const std::string& termino) {
+                if (sw.contiene(termino)) return;
+                indice.agregarTermino(termino, docID);
+                longitud++;
+            });
+        indice.agregarDocumento(url, longitud);
+    });
+}
+
+// Construye el indice invertido sobre el corpus mapeado en memoria (un docID por linea).
+// Con varios hilos, el archivo se divide en rangos de bytes alineados a saltos de linea,
+// cada hilo indexa su rango en un indice parcial y luego los parciales se fusionan por termino.
+inline EstadisticasCarga indiceInvertido(Indice& indice, const std::string& stopwordsFile, const std::string& documentosFile, unsigned hilos = 1) {
+    EstadisticasCarga stats;
+    Stopwords sw;
+    sw.cargar(stopwordsFile);
+    indice.stopwords = sw.lista();
+
+    ArchivoMapeado doc;
+    if (!doc.abrir(documentosFile)) {
+        std::cerr << "❌ Error al abrir el archivo de documentos" << std::endl;
+        return stats;
+    }
+    std::string_view texto = doc.vista();
+    auto inicio = std::chrono::high_resolution_clock::now();
+
+    if (hilos <= 1) {
+        indexarRango(texto, indice, sw);
+    } else {
+        // Limites de cada rango, movidos hasta despues del siguiente salto de linea
+        std::vector<size_t> limites(hilos + 1, texto.size());
+        limites[0] = 0;
+        for (unsigned h = 1; h < hilos; h++) {
+            size_t pos = std::max(limites[h - 1], texto.size() / hilos * h);
+            size_t salto = texto.find('\n', pos);
+            limites[h] = (salto == std::string_view::npos) ? texto.size() : salto + 1;
+        }
+
+        std::vector<Indice> parciales(hilos);
+        std::vector<std::thread> trabajadores;
+        for (unsigned h = 0; h < hilos; h++) {
+            trabajadores.emplace_back([&, h]() {
+                indexarRango(texto.substr(limites[h], limites[h + 1] - limites[h]), parciales[h], sw);
+            });
+        }
+        for (auto& t : trabajadores) t.join();
+
+        indice.fusionar(parciales, hilos);
+    }
+    indice.finalizar();
+
+    std::chrono::duration<double, std::milli> duracion = std::chrono::high_resolution_clock::now() - inicio;
+    stats.bytes = texto.size();
+    stats.ms = duracion.count();
+    return stats;
+}
+
+#endif // INDEXADOR_H
@@ -0,0 +1,407 @@
+#ifndef INDICE_H
+#define INDICE_H
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "Arreglo.h"
+#include "Compresion.h"
+#include "Document.h"
+#include "Ranking.h"
+#include "Tokenizador.h"
+
+// Lista de postings de un termino durante la construccion: docIDs ordenados y su frecuencia
+struct Postings {
+    std::vector<uint32_t> docIDs;
+    std::vector<uint32_t> frecuencias; // tf paralelo a docIDs
+
+    size_t size() const { return docIDs.size(); }
+};
+
+// Recorre los postings comprimidos de un termino decodificando un bloque a la vez.
+// Las frecuencias de un bloque solo se decodifican si se piden.
+class CursorPostings {
+private:
+    const Compresion::BloquePostings* bloques = nullptr;
+    uint32_t numBloques = 0;
+    const uint8_t* datos = nullptr;
+    uint32_t df = 0;
+
+    uint32_t actual = 0; // bloque decodificado
+    uint32_t pos = 0;    // posicion dentro del bloque
+    bool tfsListas = false;
+    uint32_t docs[Compresion::TAM_BLOQUE];
+    uint32_t tfs[Compresion::TAM_BLOQUE];
+
+    // Primer bloque desde 'desde' cuyo ultimo docID es >= objetivo (numBloques si no hay),
+    // con busqueda galopante sobre los ultimos docIDs: O(log distancia)
+    uint32_t galoparBloques(uint32_t desde, uint32_t objetivo) const {
+        uint32_t salto = 1;
+        while (desde + salto - 1 < numBloques && bloques[desde + salto - 1].ultimoDocID < objetivo) {
+            desde += salto;
+            salto *= 2;
+        }
+        uint32_t hasta = std::min(numBloques, desde + salto - 1);
+        while (desde < hasta) {
+            uint32_t medio = desde + (hasta - desde) / 2;
+            if (bloques[medio].ultimoDocID < objetivo) desde = medio + 1;
+            else hasta = medio;
+        }
+        return desde;
+    }
+
+    void cargarBloque(uint32_t b) {
+        actual = b;
+        pos = 0;
+        tfsListas = false;
+        if (b >= numBloques) return;
+        uint32_t base = b == 0 ? 0 : bloques[b - 1].ultimoDocID;
+        Compresion::decodificarDocIDs(bloques[b], datos, base, docs);
+    }
+
+public:
+    CursorPostings() {}
+
+    CursorPostings(const Compresion::BloquePostings* _bloques, uint32_t _numBloques, const uint8_t* _datos)
+        : bloques(_bloques), numBloques(_numBloques), datos(_datos) {
+        if (numBloques > 0) {
+            df = (numBloques - 1) * Compresion::TAM_BLOQUE + bloques[numBloques - 1].cantidad;
+        }
+        cargarBloque(0);
+    }
+
+    bool fin() const { return actual >= numBloques; }
+    uint32_t docID() const { return docs[pos]; }
+
+    uint32_t frecuencia() {
+        if (!tfsListas) {
+            Compresion::decodificarFrecuencias(bloques[actual], datos, tfs);
+            tfsListas = true;
+        }
+        return tfs[pos];
+    }
+
+    void siguiente() {
+        if (++pos >= bloques[actual].cantidad) cargarBloque(actual + 1);
+    }
+
+    // Avanza hasta el primer docID >= objetivo. Salta bloques completos con su ultimo docID
+    // y dentro del bloque usa busqueda galopante (exponencial + binaria); ambos pasos
+    // cuestan O(log distancia), no O(distancia).
+    void avanzarHasta(uint32_t objetivo) {
+        if (fin() || docs[pos] >= objetivo) return;
+        if (bloques[actual].ultimoDocID < objetivo) {
+            cargarBloque(galoparBloques(actual + 1, objetivo));
+            if (fin()) return;
+        }
+        uint32_t n = bloques[actual].cantidad, salto = 1, desde = pos;
+        while (desde + salto < n && docs[desde + salto] < objetivo) {
+            desde += salto;
+            salto *= 2;
+        }
+        uint32_t hasta = std::min(n - 1, desde + salto);
+        while (desde < hasta) {
+            uint32_t medio = desde + (hasta - desde) / 2;
+            if (docs[medio] < objetivo) desde = medio + 1;
+            else hasta = medio;
+        }
+        pos = desde;
+    }
+
+    // Decodifica los docIDs restantes desde la posicion actual (agota el cursor)
+    void decodificarTodo(std::vector<uint32_t>& out) {
+        out.reserve(out.size() + df);
+        while (!fin()) {
+            out.insert(out.end(), docs + pos, docs + bloques[actual].cantidad);
+            cargarBloque(actual + 1);
+        }
+    }
+
+    // Cantidad de documentos que contienen el termino
+    uint32_t size() const { return df; }
+
+    // Acceso a los metadatos de bloques (para las cotas de block-max)
+    uint32_t cantidadBloques() const { return numBloques; }
+    uint32_t bloqueActual() const { return actual; }
+    const Compresion::BloquePostings& bloque(uint32_t b) const { return bloques[b]; }
+
+    // Bloque que contendria al docID, sin decodificar nada (movimiento "superficial")
+    uint32_t bloqueDe(uint32_t docID) const {
+        if (fin() || bloques[actual].ultimoDocID >= docID) return actual;
+        return galoparBloques(actual + 1, docID);
+    }
+};
+
+// Indice invertido con diccionario de terminos internados y postings contiguos de docIDs.
+// Se construye con agregarTermino/agregarDocumento y luego finalizar() comprime todos los
+// postings en bloques de 128 (ver Compresion.h); esos arreglos tambien pueden apuntar a un
+// archivo mapeado.
+class Indice {
+public:
+    TablaDocumentos documentos;                         // docID -> URL y longitud
+    std::unordered_map<std::string, uint32_t> terminos; // termino -> termID
+    std::vector<Postings> postings;                     // termID -> postings (solo en construccion)
+    uint64_t totalTerminos = 0;                         // suma de longitudes de documentos
+
+    // Postings comprimidos: los bloques del termID t son [inicioBloques[t], inicioBloques[t+1])
+    Arreglo<uint64_t> inicioBloques;
+    Arreglo<Compresion::BloquePostings> bloques;
+    Arreglo<uint8_t> datosPostings;
+    uint64_t totalPostings = 0;
+
+    // Cota de BM25 sin idf de cada termino (la mayor de sus bloques), calculada en finalizar()
+    // con los parametros de 'parametrosCotas'; evita recorrer los bloques en cada consulta
+    Arreglo<double> cotaTerminos;
+    BM25 parametrosCotas;
+
+    std::vector<std::string> stopwords;      // stopwords con las que se construyo el indice
+    std::shared_ptr<ArchivoMapeado> archivo; // mapeo del que dependen los arreglos (si se abrio de disco)
+
+    // Registra un documento nuevo (una linea del corpus) con su URL y cantidad de terminos indexados
+    uint32_t agregarDocumento(std::string_view url, uint32_t longitud) {
+        totalTerminos += longitud;
+        return documentos.agregar(url, longitud);
+    }
+
+    // Docid que recibira el proximo documento agregado
+    uint32_t siguienteDocID() const {
+        return static_cast<uint32_t>(documentos.size());
+    }
+
+    // Agrega una ocurrencia del termino al documento. Los docIDs llegan en orden
+    // creciente, asi que basta revisar el ultimo posting para sumar la frecuencia.
+    void agregarTermino(const std::string& termino, uint32_t docID) {
+        auto it = terminos.find(termino);
+        if (it == terminos.end()) {
+            it = terminos.emplace(termino, static_cast<uint32_t>(postings.size())).first;
+            postings.emplace_back();
+        }
+        Postings& lista = postings[it->second];
+        if (lista.docIDs.empty() || lista.docIDs.back() != docID) {
+            lista.docIDs.push_back(docID);
+            lista.frecuencias.push_back(1);
+        } else {
+            lista.frecuencias.back()++;
+        }
+    }
+
+    // Comprime los postings de construccion en bloques
+    void finalizar() {
+        Compresor compresor(*this, postings.size());
+        for (auto& lista : postings) {
+            compresor.agregar(lista);
+            lista = Postings();
+        }
+        postings.clear();
+        postings.shrink_to_fit();
+        compresor.asignar(*this);
+    }
+
+    // Renumera los documentos de un indice ya finalizado: el docID d pasa a ser nuevo[d]
+    // (una permutacion). Reordena la tabla de documentos y vuelve a comprimir cada lista
+    // con los docIDs nuevos; los termIDs no cambian. Los postings anteriores se liberan al
+    // terminar, y el indice deja de depender del archivo mapeado.
+    void renumerar(const std::vector<uint32_t>& nuevo) {
+        uint32_t N = static_cast<uint32_t>(documentos.size());
+        std::vector<uint32_t> original(N);
+        for (uint32_t d = 0; d < N; d++) original[nuevo[d]] = d;
+        TablaDocumentos reordenados;
+        for (uint32_t d = 0; d < N; d++) reordenados.agregar(documentos.url(original[d]), documentos.longitud(original[d]));
+        documentos = std::move(reordenados);
+
+        Compresor compresor(*this, numTerminos());
+        std::vector<std::pair<uint32_t, uint32_t>> pares;
+        Postings lista;
+        for (uint32_t t = 0; t + 1 < inicioBloques.size(); t++) {
+            pares.clear();
+            for (CursorPostings cursor = postingsDe(t); !cursor.fin(); cursor.siguiente()) {
+                pares.emplace_back(nuevo[cursor.docID()], cursor.frecuencia());
+            }
+            std::sort(pares.begin(), pares.end());
+            lista.docIDs.clear();
+            lista.frecuencias.clear();
+            for (const auto& par : pares) {
+                lista.docIDs.push_back(par.first);
+                lista.frecuencias.push_back(par.second);
+            }
+            compresor.agregar(lista);
+        }
+        compresor.asignar(*this);
+        archivo.reset();
+    }
+
+    // Devuelve el termID o -1 si el termino no esta en el diccionario
+    int64_t buscarTermino(const std::string& termino) const {
+        auto it = terminos.find(termino);
+        return it == terminos.end() ? int64_t(-1) : int64_t(it->second);
+    }
+
+    CursorPostings postingsDe(uint32_t termID) const {
+        uint64_t inicio = inicioBloques[termID];
+        return CursorPostings(bloques.data() + inicio, static_cast<uint32_t>(inicioBloques[termID + 1] - inicio), datosPostings.data());
+    }
+
+    // Cota superior del puntaje del termino en cualquier documento de su lista: O(1) si
+    // 'bm25' usa los parametros de las cotas precalculadas, si no recorre sus bloques
+    double cotaTermino(uint32_t termID, const BM25& bm25, double idf) const {
+        // el margen cubre diferencias de redondeo entre la cota y el puntaje real
+        if (bm25.k1 == parametrosCotas.k1 && bm25.b == parametrosCotas.b) return cotaTerminos[termID] * idf * (1.0 + 1e-9);
+        double promedio = longitudPromedio(), cota = 0.0;
+        for (uint64_t b = inicioBloques[termID]; b < inicioBloques[termID + 1]; b++) {
+            cota = std::max(cota, bm25.puntaje(bloques[b].maxTf, bloques[b].minLongitud, promedio, idf) * (1.0 + 1e-9));
+        }
+        return cota;
+    }
+
+    // Devuelve un cursor sobre los postings de un termino (vacio si no esta en el diccionario)
+    CursorPostings buscar(const std::string& termino) const {
+        int64_t termID = buscarTermino(termino);
+        if (termID < 0) return CursorPostings();
+        return postingsDe(static_cast<uint32_t>(termID));
+    }
+
+    std::string_view url(uint32_t docID) const {
+        return documentos.url(docID);
+    }
+
+    uint32_t longitud(uint32_t docID) const {
+        return documentos.longitud(docID);
+    }
+
+    double longitudPromedio() const {
+        if (documentos.size() == 0) return 0.0;
+        return static_cast<double>(totalTerminos) / documentos.size();
+    }
+
+    size_t numDocumentos() const { return documentos.size(); }
+    size_t numTerminos() const { return terminos.size(); }
+    size_t numPostings() const { return totalPostings; }
+
+    // Bytes ocupados por los postings comprimidos (datos + metadatos de bloques y de terminos)
+    size_t bytesPostings() const {
+        return datosPostings.size() + bloques.size() * sizeof(Compresion::BloquePostings) + inicioBloques.size() * sizeof(uint64_t) +
+               cotaTerminos.size() * sizeof(double);
+    }
+
+    // Fusiona indices parciales construidos sobre rangos consecutivos del corpus.
+    // Los docIDs de cada parcial se desplazan por los documentos de los anteriores,
+    // asi que concatenar sus postings en orden mantiene las listas ordenadas.
+    // Los terminos se reparten por hash entre los hilos y cada hilo fusiona su particion.
+    // Se llama sobre un indice vacio; los parciales aun no estan finalizados.
+    void fusionar(std::vector<Indice>& parciales, unsigned hilos) {
+        if (hilos == 0) hilos = 1;
+        std::vector<uint32_t> desplazamiento(parciales.size(), 0);
+        for (size_t s = 0; s < parciales.size(); s++) {
+            desplazamiento[s] = static_cast<uint32_t>(documentos.size());
+            for (uint32_t d = 0; d < parciales[s].documentos.size(); d++) {
+                agregarDocumento(parciales[s].url(d), parciales[s].longitud(d));
+            }
+            parciales[s].documentos = TablaDocumentos();
+        }
+
+        // Cada parcial agrupa sus terminos por particion de destino
+        std::vector<std::vector<std::vector<const std::string*>>> porParticion(parciales.size());
+        paraCadaHilo(static_cast<unsigned>(parciales.size()), [&](unsigned s) {
+            porParticion[s].resize(hilos);
+            for (const auto& par : parciales[s].terminos) {
+                porParticion[s][std::hash<std::string>()(par.first) % hilos].push_back(&par.first);
+            }
+        });
+
+        // Fusion por termino: cada hilo es dueno de una particion
+        std::vector<std::vector<std::pair<std::string, Postings>>> fusionados(hilos);
+        paraCadaHilo(hilos, [&](unsigned h) {
+            std::unordered_map<std::string, size_t> posicion;
+            for (size_t s = 0; s < parciales.size(); s++) {
+                for (const std::string* termino : porParticion[s][h]) {
+                    Postings& origen = parciales[s].postings[parciales[s].terminos.at(*termino)];
+                    auto it = posicion.find(*termino);
+                    if (it == posicion.end()) {
+                        it = posicion.emplace(*termino, fusionados[h].size()).first;
+                        fusionados[h].emplace_back(*termino, Postings());
+                    }
+                    Postings& destino = fusionados[h][it->second].second;
+                    for (size_t i = 0; i < origen.size(); i++) {
+                        destino.docIDs.push_back(origen.docIDs[i] + desplazamiento[s]);
+                    }
+                    destino.frecuencias.insert(destino.frecuencias.end(), origen.frecuencias.begin(), origen.frecuencias.end());
+                    origen = Postings(); // liberar memoria del parcial
+                }
+            }
+        });
+
+        size_t total = 0;
+        for (const auto& particion : fusionados) total += particion.size();
+        terminos.reserve(total);
+        postings.reserve(total);
+        for (auto& particion : fusionados) {
+            for (auto& par : particion) {
+                terminos.emplace(std::move(par.first), static_cast<uint32_t>(postings.size()));
+                postings.push_back(std::move(par.second));
+            }
+        }
+    }
+
+private:
+    // Comprime listas de postings, una por termID en orden, en los arreglos del indice
+    struct Compresor {
+        const Indice& indice;
+        std::vector<uint64_t> inicio;
+        std::vector<Compresion::BloquePostings> bloques;
+        std::vector<uint8_t> datos;
+        std::vector<double> cotas;
+        uint64_t totalPostings = 0;
+        double promedio;
+
+        Compresor(const Indice& indice, size_t numTerminos) : indice(indice), promedio(indice.longitudPromedio()) {
+            inicio.reserve(numTerminos + 1);
+            inicio.push_back(0);
+            cotas.reserve(numTerminos);
+        }
+
+        void agregar(const Postings& lista) {
+            uint32_t base = 0;
+            double cota = 0.0;
+            for (size_t i = 0; i < lista.size(); i += Compresion::TAM_BLOQUE) {
+                uint32_t n = static_cast<uint32_t>(std::min<size_t>(Compresion::TAM_BLOQUE, lista.size() - i));
+                Compresion::BloquePostings bloque = Compresion::codificarBloque(&lista.docIDs[i], &lista.frecuencias[i], n, base, datos);
+                bloque.minLongitud = indice.longitud(lista.docIDs[i]);
+                for (uint32_t j = 1; j < n; j++) {
+                    bloque.minLongitud = std::min(bloque.minLongitud, indice.longitud(lista.docIDs[i + j]));
+                }
+                cota = std::max(cota, indice.parametrosCotas.puntaje(bloque.maxTf, bloque.minLongitud, promedio, 1.0));
+                bloques.push_back(bloque);
+                base = lista.docIDs[i + n - 1];
+            }
+            inicio.push_back(bloques.size());
+            cotas.push_back(cota);
+            totalPostings += lista.size();
+        }
+
+        void asignar(Indice& destino) {
+            destino.totalPostings = totalPostings;
+            destino.inicioBloques.asignar(std::move(inicio));
+            destino.bloques.asignar(std::move(bloques));
+            destino.datosPostings.asignar(std::move(datos));
+            destino.cotaTerminos.asignar(std::move(cotas));
+        }
+    };
+
+    // Ejecuta f(0..n-1), cada llamada en su propio hilo
+    template <typename F>
+    static void paraCadaHilo(unsigned n, F f) {
+        std::vector<std::thread> trabajadores;
+        for (unsigned i = 0; i < n; i++) {
+            trabajadores.emplace_back(f, i);
+        }
+        for (auto& t : trabajadores) t.join();
+    }
+};
+
+#endif // INDICE_H
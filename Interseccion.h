@@ -0,0 +1,91 @@
+#ifndef INTERSECCION_H
+#define INTERSECCION_H
+#include <cstdint>
+#include <vector>
+#if defined(__x86_64__) || defined(_M_X64)
+#include <emmintrin.h>
+#define INTERSECCION_SSE2 1
+#endif
+
+// Interseccion de listas ordenadas de docIDs (sin repetidos)
+namespace Interseccion {
+
+// Merge escalar clasico: O(|a| + |b|)
+inline void intersectarEscalar(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, std::vector<uint32_t>& out) {
+    size_t i = 0, j = 0;
+    while (i < na && j < nb) {
+        if (a[i] < b[j]) i++;
+        else if (a[i] > b[j]) j++;
+        else { out.push_back(a[i]); i++; j++; }
+    }
+}
+
+// Comparacion por bloques de 4 con SSE2: cada bloque de 'a' se compara contra el bloque
+// actual de 'b' y sus 3 rotaciones, y avanza el bloque cuyo maximo sea menor. Conviene
+// cuando ambas listas tienen tamanos parecidos; si no, es mejor galopar.
+inline void intersectarSIMD(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, std::vector<uint32_t>& out) {
+    size_t i = 0, j = 0;
+#ifdef INTERSECCION_SSE2
+    while (i + 4 <= na && j + 4 <= nb) {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+        __m128i eq = _mm_cmpeq_epi32(va, vb);
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1))));
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))));
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3))));
+        int mascara = _mm_movemask_ps(_mm_castsi128_ps(eq));
+        for (int k = 0; k < 4; k++) {
+            if (mascara & (1 << k)) out.push_back(a[i + k]);
+        }
+        uint32_t maxA = a[i + 3], maxB = b[j + 3];
+        if (maxA <= maxB) i += 4;
+        if (maxB <= maxA) j += 4;
+    }
+#endif
+    intersectarEscalar(a + i, na - i, b + j, nb - j, out);
+}
+
+// Primer indice en [desde, n) con v[indice] >= objetivo, por busqueda galopante
+inline size_t galopar(const uint32_t* v, size_t desde, size_t n, uint32_t objetivo) {
+    if (desde >= n || v[desde] >= objetivo) return desde;
+    size_t salto = 1;
+    while (desde + salto < n && v[desde + salto] < objetivo) {
+        desde += salto;
+        salto *= 2;
+    }
+    size_t hasta = (desde + salto < n) ? desde + salto : n;
+    desde++;
+    while (desde < hasta) {
+        size_t medio = desde + (hasta - desde) / 2;
+        if (v[medio] < objetivo) desde = medio + 1;
+        else hasta = medio;
+    }
+    return desde;
+}
+
+// Interseccion galopante: recorre la lista corta y busca cada elemento en la larga.
+// O(|corta| log(|larga| / |corta|)).
+inline void intersectarGalopando(const uint32_t* corta, size_t nc, const uint32_t* larga, size_t nl, std::vector<uint32_t>& out) {
+    size_t j = 0;
+    for (size_t i = 0; i < nc && j < nl; i++) {
+        j = galopar(larga, j, nl, corta[i]);
+        if (j < nl && larga[j] == corta[i]) out.push_back(corta[i]);
+    }
+}
+
+// Proporcion de tamanos a partir de la cual galopar le gana al merge SIMD
+const size_t PROPORCION_GALOPE = 8;
+
+inline void intersectar(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b, std::vector<uint32_t>& out) {
+    const std::vector<uint32_t>& corta = a.size() <= b.size() ? a : b;
+    const std::vector<uint32_t>& larga = a.size() <= b.size() ? b : a;
+    if (larga.size() > corta.size() * PROPORCION_GALOPE) {
+        intersectarGalopando(corta.data(), corta.size(), larga.data(), larga.size(), out);
+    } else {
+        intersectarSIMD(corta.data(), corta.size(), larga.data(), larga.size(), out);
+    }
+}
+
+} // namespace Interseccion
+
+#endif // INTERSECCION_H
@@ -1,295 +1,292 @@
 #ifndef LRUCACHE_H
 #define LRUCACHE_H
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <vector>
 
-// Nodo para el cache LRU
-class CacheNode {
+// Bytes de memoria dinamica de una clave o valor (lo que no esta dentro del nodo).
+// Cada tipo de valor del cache define su propia sobrecarga.
+inline size_t bytesDinamicos(const std::string& s) {
+    return s.size();
+}
+
+inline size_t bytesDinamicos(uint64_t) {
+    return 0;
+}
+
+// Hash de las claves del cache
+inline uint64_t hashClave(const std::string& key) {
+    return std::hash<std::string>()(key);
+}
+
+// Las claves de 64 bits ya son hashes; se mezclan para repartir bien los bits bajos
+inline uint64_t hashClave(uint64_t key) {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdull;
+    key ^= key >> 33;
+    return key;
+}
+
+// Interfaz comun de los caches con capacidad en bytes (una implementacion por politica
+// de desalojo; ver PoliticasCache.h). put devuelve cuantas entradas se desalojaron.
+template <typename Valor, typename Clave>
+class CacheBase {
 public:
-    std::string key;
-    std::string value;
-    CacheNode* next;
-    
-    CacheNode(std::string _key, std::string _value) : key(_key), value(_value), next(nullptr) {}
+    virtual ~CacheBase() {}
+    virtual const char* politica() const = 0;
+    // Copia el valor en 'value' si la clave esta; cuenta como acceso para la politica
+    virtual bool get(const Clave& key, Valor& value) = 0;
+    virtual int put(const Clave& key, const Valor& value) = 0;
+    virtual bool contains(const Clave& key) const = 0;
+    virtual int getSize() const = 0;
+    virtual size_t getBytes() const = 0;
+    virtual size_t getMaxBytes() const = 0;
+    virtual std::vector<Clave> getAllKeys() const = 0;
+    virtual void clear() = 0;
+    // Aplica f a cada valor guardado sin contarlo como acceso; f no cambia su tamano
+    virtual void transformar(const std::function<void(Valor&)>& f) = 0;
+
+    // Valor de la clave (vacio si no esta)
+    Valor get(const Clave& key) {
+        Valor value;
+        get(key, value);
+        return value;
+    }
 };
 
-// Stack para implementar LRU
-class LRUStack {
+// Cache LRU con get/put/evict en O(1) y capacidad en bytes.
+// Cada entrada vive una sola vez en un arreglo de nodos; los nodos forman una lista
+// doblemente enlazada intrusiva (por indices) en orden de uso, y una tabla hash de
+// direccionamiento abierto (sondeo lineal) apunta a ellos. La tabla crece al doble
+// cuando supera la mitad de ocupacion. Cada entrada cuenta su nodo, sus casillas de
+// la tabla y la memoria dinamica de clave y valor; se desalojan las menos recientes
+// hasta que el total entra en la capacidad.
+// Las claves son strings o hashes de 64 bits; el valor puede ser cualquier tipo copiable.
+template <typename Valor = std::string, typename Clave = std::string>
+class LRUCache : public CacheBase<Valor, Clave> {
 private:
-    CacheNode* top;
-    int size;
-    int maxSize;
-    
-public:
-    // Constructor al que se le pasa el tamano maximo del stack.
-    LRUStack(int _maxSize) : top(nullptr), size(0), maxSize(_maxSize) {}
-    
-    // Destructor para liberar memoria y evitar el memory leak.
-    ~LRUStack() {
-        while (top != nullptr) {
-            CacheNode* temp = top;
-            top = top->next;
-            delete temp;
-        }
-    }
-    
-    void push(std::string key, std::string value) {
-        CacheNode* newNode = new CacheNode(key, value);
-        newNode->next = top;
-        top = newNode;
-        size++;
-        
-        // Si excede el tamano, eliminar el ultimo
-        if (size > maxSize) {
-            removeLast();
+    static constexpr int32_t NINGUNO = -1;
+
+    // Nodo del cache: clave, valor y enlaces de la lista de uso
+    struct CacheNode {
+        Clave key;
+        Valor value;
+        uint64_t hash;
+        size_t bytes;  // costo de la entrada
+        int32_t prev;
+        int32_t next;
+    };
+
+    std::vector<CacheNode> nodos;  // los nodos desalojados se reutilizan
+    std::vector<int32_t> libres;   // nodos sin usar
+    std::vector<int32_t> tabla;    // indices de nodos, NINGUNO = casilla vacia
+    size_t mascara = 0;
+    int32_t cabeza = NINGUNO;      // mas reciente
+    int32_t cola = NINGUNO;        // menos reciente
+    int size = 0;
+    size_t bytes = 0;
+    size_t maxBytes;
+
+    // Casilla de la tabla con la clave, o la casilla vacia donde iria
+    size_t buscarCasilla(const Clave& key, uint64_t hash) const {
+        size_t i = hash & mascara;
+        while (tabla[i] != NINGUNO) {
+            const CacheNode& nodo = nodos[tabla[i]];
+            if (nodo.hash == hash && nodo.key == key) return i;
+            i = (i + 1) & mascara;
         }
+        return i;
     }
-    
-    bool remove(std::string key) {
-        if (top == nullptr) return false;
-        
-        // Si es el primero
-        if (top->key == key) {
-            CacheNode* temp = top;
-            top = top->next;
-            delete temp;
-            size--;
-            return true;
-        }
-        
-        // Buscar en el resto
-        CacheNode* current = top;
-        while (current->next != nullptr) {
-            if (current->next->key == key) {
-                CacheNode* temp = current->next;
-                current->next = current->next->next;
-                delete temp;
-                size--;
-                return true;
+
+    // Borra una casilla desplazando hacia atras las que siguen (sin lapidas)
+    void borrarCasilla(size_t i) {
+        size_t j = i;
+        while (true) {
+            j = (j + 1) & mascara;
+            if (tabla[j] == NINGUNO) break;
+            size_t ideal = nodos[tabla[j]].hash & mascara;
+            // Se mueve j a i si su posicion ideal no queda entre i (exclusivo) y j (inclusivo)
+            bool entre = i <= j ? (i < ideal && ideal <= j) : (i < ideal || ideal <= j);
+            if (!entre) {
+                tabla[i] = tabla[j];
+                i = j;
             }
-            current = current->next;
         }
-        return false;
+        tabla[i] = NINGUNO;
     }
-    
-    void removeLast() {
-        if (top == nullptr) return;
-        
-        if (top->next == nullptr) {
-            delete top;
-            top = nullptr;
-            size = 0;
-            return;
-        }
-        
-        CacheNode* current = top;
-        while (current->next->next != nullptr) {
-            current = current->next;
+
+    void redimensionar(size_t casillas) {
+        tabla.assign(casillas, NINGUNO);
+        mascara = casillas - 1;
+        for (int32_t n = cabeza; n != NINGUNO; n = nodos[n].next) {
+            size_t i = nodos[n].hash & mascara;
+            while (tabla[i] != NINGUNO) i = (i + 1) & mascara;
+            tabla[i] = n;
         }
-        delete current->next;
-        current->next = nullptr;
-        size--;
     }
-    
-    std::string getLRUKey() {
-        if (top == nullptr) return "";
-        
-        CacheNode* current = top;
-        while (current->next != nullptr) {
-            current = current->next;
-        }
-        return current->key;
+
+    void desenlazar(int32_t n) {
+        CacheNode& nodo = nodos[n];
+        if (nodo.prev != NINGUNO) nodos[nodo.prev].next = nodo.next; else cabeza = nodo.next;
+        if (nodo.next != NINGUNO) nodos[nodo.next].prev = nodo.prev; else cola = nodo.prev;
+    }
+
+    void enlazarAlFrente(int32_t n) {
+        nodos[n].prev = NINGUNO;
+        nodos[n].next = cabeza;
+        if (cabeza != NINGUNO) nodos[cabeza].prev = n;
+        cabeza = n;
+        if (cola == NINGUNO) cola = n;
+    }
+
+    static size_t bytesEntrada(const Clave& key, const Valor& value) {
+        // la tabla se mantiene a menos de la mitad: dos casillas por entrada
+        return sizeof(CacheNode) + 2 * sizeof(int32_t) + bytesDinamicos(key) + bytesDinamicos(value);
+    }
+
+    // Saca el nodo de la tabla y de la lista y lo deja libre
+    void desalojar(int32_t n) {
+        borrarCasilla(buscarCasilla(nodos[n].key, nodos[n].hash));
+        desenlazar(n);
+        bytes -= nodos[n].bytes;
+        nodos[n].key = Clave();
+        nodos[n].value = Valor();
+        libres.push_back(n);
+        size--;
     }
-    
-    // Obtener todas las claves en orden de uso (mas reciente primero)
-    std::vector<std::string> getAllKeys() const {
-        std::vector<std::string> keys;
-        CacheNode* current = top;
-        while (current != nullptr) {
-            keys.push_back(current->key);
-            current = current->next;
+
+    // Desaloja las entradas menos recientes (salvo 'proteger') hasta entrar en la capacidad
+    int liberarEspacio(int32_t proteger) {
+        int desalojados = 0;
+        while (bytes > maxBytes && cola != NINGUNO && cola != proteger) {
+            desalojar(cola);
+            desalojados++;
         }
-        return keys;
+        return desalojados;
     }
-    
-    int getSize() const { return size; }
-    int getMaxSize() const { return maxSize; }
-    bool isEmpty() const { return size == 0; }
-    bool isFull() const { return size >= maxSize; }
-};
 
-// Tabla Hash para el cache
-class HashTable {
-private:
-    static const int TABLE_SIZE = 101; // Numero primo para mejor distribucion
-    CacheNode* table[TABLE_SIZE];
-    
-    // distribucion de claves a indices
-    int hashFunction(const std::string& key) {
-        int hash = 0;
-        for (char c : key) {
-            hash = (hash * 31 + c) % TABLE_SIZE;
+    // Nodo con la clave (y lo marca como el mas reciente), o NINGUNO
+    int32_t usar(const Clave& key) {
+        if (size == 0) return NINGUNO;
+        size_t i = buscarCasilla(key, hashClave(key));
+        int32_t n = tabla[i];
+        if (n != NINGUNO && n != cabeza) {
+            desenlazar(n);
+            enlazarAlFrente(n);
         }
-        return hash;
+        return n;
     }
-    
+
 public:
-    HashTable() {
-        for (int i = 0; i < TABLE_SIZE; i++) {
-            table[i] = nullptr;
-        }
+    LRUCache(size_t _maxBytes) : maxBytes(_maxBytes) {
+        redimensionar(16);
     }
-    
-    ~HashTable() {
-        for (int i = 0; i < TABLE_SIZE; i++) {
-            CacheNode* current = table[i];
-            while (current != nullptr) {
-                CacheNode* temp = current;
-                current = current->next;
-                delete temp;
-            }
-        }
+
+    const char* politica() const override { return "lru"; }
+
+    // Valor de la clave (vacio si no esta); la marca como la mas reciente
+    Valor get(const Clave& key) {
+        int32_t n = usar(key);
+        return n == NINGUNO ? Valor() : nodos[n].value;
     }
-    
-    void put(std::string key, std::string value) {
-        int index = hashFunction(key);
-        
-        // Buscar si ya existe
-        CacheNode* current = table[index];
-        while (current != nullptr) {
-            if (current->key == key) {
-                current->value = value; // Actualizar valor
-                return;
-            }
-            current = current->next;
-        }
-        
-        // Insertar nuevo nodo
-        CacheNode* newNode = new CacheNode(key, value);
-        newNode->next = table[index];
-        table[index] = newNode;
+
+    // Copia el valor en 'value' si la clave esta (una sola busqueda); la marca como la mas reciente
+    bool get(const Clave& key, Valor& value) override {
+        int32_t n = usar(key);
+        if (n == NINGUNO) return false;
+        value = nodos[n].value;
+        return true;
     }
-    
-    std::string get(std::string key) {
-        int index = hashFunction(key);
-        CacheNode* current = table[index];
-        
-        while (current != nullptr) {
-            if (current->key == key) {
-                return current->value;
+
+    // Inserta o actualiza la clave y devuelve cuantas entradas se desalojaron.
+    // Una entrada mas grande que toda la capacidad no se guarda.
+    int put(const Clave& key, const Valor& value) override {
+        size_t costo = bytesEntrada(key, value);
+        uint64_t hash = hashClave(key);
+        size_t i = buscarCasilla(key, hash);
+        if (tabla[i] != NINGUNO) {
+            // Si ya existe, actualizar
+            int32_t n = tabla[i];
+            if (costo > maxBytes) {
+                desalojar(n);
+                return 1;
             }
-            current = current->next;
+            bytes += costo - nodos[n].bytes;
+            nodos[n].value = value;
+            nodos[n].bytes = costo;
+            if (n != cabeza) {
+                desenlazar(n);
+                enlazarAlFrente(n);
+            }
+            return liberarEspacio(n);
         }
-        return ""; // No encontrado
-    }
-    
-    bool remove(std::string key) {
-        int index = hashFunction(key);
-        CacheNode* current = table[index];
-        
-        if (current == nullptr) return false;
-        
-        // Si es el primero
-        if (current->key == key) {
-            table[index] = current->next;
-            delete current;
-            return true;
+        if (costo > maxBytes) return 0;
+
+        int32_t n;
+        if (!libres.empty()) {
+            n = libres.back();
+            libres.pop_back();
+        } else {
+            n = static_cast<int32_t>(nodos.size());
+            nodos.push_back(CacheNode());
         }
-        
-        // Buscar en el resto
-        while (current->next != nullptr) {
-            if (current->next->key == key) {
-                CacheNode* temp = current->next;
-                current->next = current->next->next;
-                delete temp;
-                return true;
-            }
-            current = current->next;
+        if (static_cast<size_t>(size + 1) * 2 > tabla.size()) {
+            redimensionar(tabla.size() * 2);
+            i = buscarCasilla(key, hash);
         }
-        return false;
+
+        nodos[n].key = key;
+        nodos[n].value = value;
+        nodos[n].hash = hash;
+        nodos[n].bytes = costo;
+        tabla[i] = n;
+        enlazarAlFrente(n);
+        size++;
+        bytes += costo;
+        return liberarEspacio(n);
     }
-    
-    bool contains(std::string key) {
-        return get(key) != "";
+
+    bool contains(const Clave& key) const override {
+        return size > 0 && tabla[buscarCasilla(key, hashClave(key))] != NINGUNO;
     }
-};
 
-// Cache LRU combinando HashTable y Stack
-class LRUCache {
-private:
-    HashTable* hashTable;
-    LRUStack* lruStack;
-    int maxSize;
-    
-public:
-    LRUCache(int _maxSize) : maxSize(_maxSize) {
-        hashTable = new HashTable();
-        lruStack = new LRUStack(_maxSize);
+    int getSize() const override {
+        return size;
     }
-    
-    ~LRUCache() {
-        delete hashTable;
-        delete lruStack;
+
+    size_t getBytes() const override {
+        return bytes;
     }
-    
-    std::string get(std::string key) {
-        std::string value = hashTable->get(key);
-        if (value != "") {
-            // Mover al tope (mas reciente)
-            lruStack->remove(key);
-            lruStack->push(key, value);
-            return value;
-        }
-        return ""; // No encontrado
+
+    size_t getMaxBytes() const override {
+        return maxBytes;
     }
-    
-    void put(std::string key, std::string value) {
-        // Si ya existe, actualizar
-        if (hashTable->contains(key)) {
-            hashTable->put(key, value);
-            lruStack->remove(key);
-            lruStack->push(key, value);
-            return;
-        }
-        
-        // Si esta lleno, eliminar LRU
-        if (lruStack->isFull()) {
-            std::string lruKey = lruStack->getLRUKey();
-            hashTable->remove(lruKey);
-            lruStack->removeLast();
+
+    // Obtener todas las claves del cache en orden de uso (mas reciente primero)
+    std::vector<Clave> getAllKeys() const override {
+        std::vector<Clave> keys;
+        keys.reserve(size);
+        for (int32_t n = cabeza; n != NINGUNO; n = nodos[n].next) {
+            keys.push_back(nodos[n].key);
         }
-        
-        // Insertar nuevo
-        hashTable->put(key, value);
-        lruStack->push(key, value);
-    }
-    
-    bool contains(std::string key) {
-        return hashTable->contains(key);
-    }
-    
-    int getSize() const {
-        return lruStack->getSize();
-    }
-    
-    int getMaxSize() const {
-        return maxSize;
+        return keys;
     }
-    
-    // Obtener todas las claves del cache en orden de uso (mas reciente primero)
-    std::vector<std::string> getAllKeys() const {
-        return lruStack->getAllKeys();
+
+    void transformar(const std::function<void(Valor&)>& f) override {
+        for (int32_t n = cabeza; n != NINGUNO; n = nodos[n].next) {
+            f(nodos[n].value);
+        }
     }
-    
+
     // Limpiar todo el contenido del cache
-    void clear() {
-        // Limpiar la tabla hash
-        delete hashTable;
-        hashTable = new HashTable();
-        
-        // Limpiar el stack LRU
-        delete lruStack;
-        lruStack = new LRUStack(maxSize);
+    void clear() override {
+        nodos.clear();
+        libres.clear();
+        cabeza = cola = NINGUNO;
+        size = 0;
+        bytes = 0;
+        redimensionar(16);
     }
 };
 
@@ -0,0 +1,300 @@
+#ifndef METRICAS_H
+#define METRICAS_H
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+// Etapas del procesamiento de una consulta con histograma de latencia propio
+enum class Etapa : uint32_t {
+    TOKENIZAR,  // separar la consulta en palabras en minuscula y descartar stopwords
+    NORMALIZAR, // ordenar, quitar repetidas y calcular la clave
+    CACHE,      // busqueda en el cache
+    LISTAS,     // buscar los terminos en el diccionario con sus cotas (y en AND, intersectar las listas)
+    RECORRIDO,  // BM25 y top-k; en OR es todo Block-Max WAND, con el avance y la decodificacion de los cursores
+    FORMATO,    // texto del resultado
+    GRAFO,      // aristas de co-relevancia de la consulta
+    NUM_ETAPAS
+};
+
+inline const char* nombreEtapa(Etapa etapa) {
+    switch (etapa) {
+        case Etapa::TOKENIZAR: return "tokenizar";
+        case Etapa::NORMALIZAR: return "normalizar";
+        case Etapa::CACHE: return "cache";
+        case Etapa::LISTAS: return "listas";
+        case Etapa::RECORRIDO: return "recorrido";
+        case Etapa::FORMATO: return "formato";
+        default: return "grafo";
+    }
+}
+
+enum class Contador : uint32_t {
+    CONSULTAS,
+    HITS,
+    MISSES,
+    INSERCIONES,
+    REEMPLAZOS, // entradas desalojadas del cache
+    NUM_CONTADORES
+};
+
+inline const char* nombreContador(Contador contador) {
+    switch (contador) {
+        case Contador::CONSULTAS: return "consultas";
+        case Contador::HITS: return "hits";
+        case Contador::MISSES: return "misses";
+        case Contador::INSERCIONES: return "inserciones";
+        default: return "reemplazos";
+    }
+}
+
+// Histograma log-lineal de latencias en ns, al estilo HDR: los valores menores a 32 tienen
+// casilla propia y cada potencia de dos mayor se divide en 32 casillas, asi el error
+// relativo es menor al 3% en todo el rango (hasta 2^40 ns, unos 18 minutos).
+// Lo escribe un solo hilo, con cargas y escrituras relajadas (sin instrucciones atomicas
+// de lectura-modificacion-escritura); cualquier hilo lo puede leer mientras tanto.
+class Histograma {
+public:
+    static constexpr uint32_t BITS_SUB = 5;
+    static constexpr uint32_t SUB = 1u << BITS_SUB;
+    static constexpr uint32_t MAX_BITS = 40;
+    static constexpr uint32_t CASILLAS = (MAX_BITS - BITS_SUB + 1) * SUB;
+
+    std::atomic<uint64_t> cuentas[CASILLAS];
+    std::atomic<uint64_t> total;
+    std::atomic<uint64_t> suma;
+    std::atomic<uint64_t> maximo;
+
+    Histograma() {
+        for (auto& cuenta : cuentas) cuenta.store(0, std::memory_order_relaxed);
+        total.store(0, std::memory_order_relaxed);
+        suma.store(0, std::memory_order_relaxed);
+        maximo.store(0, std::memory_order_relaxed);
+    }
+
+    // Posicion del bit mas alto (v > 0)
+    static uint32_t bitMasAlto(uint64_t v) {
+#if defined(__GNUC__)
+        return 63 - static_cast<uint32_t>(__builtin_clzll(v));
+#else
+        uint32_t bits = 0;
+        while (v >>= 1) bits++;
+        return bits;
+#endif
+    }
+
+    static uint32_t casilla(uint64_t v) {
+        if (v < SUB) return static_cast<uint32_t>(v);
+        uint32_t bits = bitMasAlto(v);
+        if (bits >= MAX_BITS) return CASILLAS - 1;
+        return (bits - BITS_SUB + 1) * SUB + static_cast<uint32_t>((v >> (bits - BITS_SUB)) - SUB);
+    }
+
+    // Punto medio de los valores de la casilla
+    static uint64_t representante(uint32_t c) {
+        if (c < SUB) return c;
+        uint32_t desplazamiento = c / SUB - 1;
+        uint64_t inicio = static_cast<uint64_t>(SUB + c % SUB) << desplazamiento;
+        return inicio + ((uint64_t(1) << desplazamiento) >> 1);
+    }
+
+    void agregar(uint64_t v) {
+        sumar(cuentas[casilla(v)], 1);
+        sumar(total, 1);
+        sumar(suma, v);
+        if (v > maximo.load(std::memory_order_relaxed)) maximo.store(v, std::memory_order_relaxed);
+    }
+
+    // Incremento de un contador que escribe un solo hilo
+    static void sumar(std::atomic<uint64_t>& contador, uint64_t n) {
+        contador.store(contador.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+};
+
+// Copia fija de uno o varios histogramas, para calcular percentiles
+struct ResumenHistograma {
+    std::vector<uint64_t> cuentas = std::vector<uint64_t>(Histograma::CASILLAS, 0);
+    uint64_t total = 0;
+    uint64_t suma = 0;
+    uint64_t maximo = 0;
+
+    void agregar(const Histograma& h) {
+        for (uint32_t c = 0; c < Histograma::CASILLAS; c++) cuentas[c] += h.cuentas[c].load(std::memory_order_relaxed);
+        total += h.total.load(std::memory_order_relaxed);
+        suma += h.suma.load(std::memory_order_relaxed);
+        maximo = std::max(maximo, h.maximo.load(std::memory_order_relaxed));
+    }
+
+    void agregar(const ResumenHistograma& r) {
+        for (uint32_t c = 0; c < Histograma::CASILLAS; c++) cuentas[c] += r.cuentas[c];
+        total += r.total;
+        suma += r.suma;
+        maximo = std::max(maximo, r.maximo);
+    }
+
+    double promedio() const {
+        return total > 0 ? static_cast<double>(suma) / total : 0.0;
+    }
+
+    // Valor (en ns) por debajo del cual queda la fraccion p de las muestras
+    uint64_t percentil(double p) const {
+        if (total == 0) return 0;
+        uint64_t rango = std::max<uint64_t>(1, static_cast<uint64_t>(p * total + 0.999999));
+        uint64_t acumulado = 0;
+        for (uint32_t c = 0; c < Histograma::CASILLAS; c++) {
+            acumulado += cuentas[c];
+            if (acumulado >= rango) return std::min(Histograma::representante(c), maximo);
+        }
+        return maximo;
+    }
+};
+
+// Registro global de contadores e histogramas por etapa.
+// Cada hilo escribe en su propio buffer (sin locks ni lineas de cache compartidas), que se
+// registra la primera vez que el hilo mide algo; la lectura junta los buffers de los hilos
+// vivos bajo el mutex, y cuando un hilo termina su buffer se suma al de los retirados.
+// reiniciarContadores() no toca los buffers: guarda los valores actuales como base.
+class RegistroMetricas {
+private:
+    struct BufferHilo {
+        std::atomic<uint64_t> contadores[static_cast<size_t>(Contador::NUM_CONTADORES)];
+        Histograma etapas[static_cast<size_t>(Etapa::NUM_ETAPAS)];
+
+        BufferHilo() {
+            for (auto& contador : contadores) contador.store(0, std::memory_order_relaxed);
+        }
+    };
+
+    // Da de baja el buffer del hilo cuando el hilo termina
+    struct RegistroHilo {
+        std::shared_ptr<BufferHilo> buffer;
+        ~RegistroHilo() {
+            if (buffer) global().retirar(buffer);
+        }
+    };
+
+    static constexpr size_t NUM_CONTADORES = static_cast<size_t>(Contador::NUM_CONTADORES);
+    static constexpr size_t NUM_ETAPAS = static_cast<size_t>(Etapa::NUM_ETAPAS);
+
+    std::mutex mutex;
+    std::vector<std::shared_ptr<BufferHilo>> buffers; // de los hilos vivos
+    uint64_t contadoresRetirados[NUM_CONTADORES] = {};
+    ResumenHistograma etapasRetiradas[NUM_ETAPAS];
+    uint64_t base[NUM_CONTADORES] = {};
+
+    RegistroMetricas() = default;
+
+    BufferHilo& buffer() {
+        thread_local RegistroHilo registro;
+        if (!registro.buffer) {
+            registro.buffer = std::make_shared<BufferHilo>();
+            std::lock_guard<std::mutex> lock(mutex);
+            buffers.push_back(registro.buffer);
+        }
+        return *registro.buffer;
+    }
+
+    void retirar(const std::shared_ptr<BufferHilo>& b) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (size_t c = 0; c < NUM_CONTADORES; c++) contadoresRetirados[c] += b->contadores[c].load(std::memory_order_relaxed);
+        for (size_t e = 0; e < NUM_ETAPAS; e++) etapasRetiradas[e].agregar(b->etapas[e]);
+        buffers.erase(std::remove(buffers.begin(), buffers.end(), b), buffers.end());
+    }
+
+    uint64_t contadorSinBase(size_t c) {
+        uint64_t suma = contadoresRetirados[c];
+        for (const auto& b : buffers) suma += b->contadores[c].load(std::memory_order_relaxed);
+        return suma;
+    }
+
+public:
+    std::atomic<bool> activas{true}; // con false los cronometros no leen el reloj
+
+    static RegistroMetricas& global() {
+        static RegistroMetricas registro;
+        return registro;
+    }
+
+    void sumar(Contador contador, uint64_t n = 1) {
+        Histograma::sumar(buffer().contadores[static_cast<size_t>(contador)], n);
+    }
+
+    void registrar(Etapa etapa, uint64_t nanosegundos) {
+        buffer().etapas[static_cast<size_t>(etapa)].agregar(nanosegundos);
+    }
+
+    uint64_t contador(Contador contador) {
+        std::lock_guard<std::mutex> lock(mutex);
+        size_t c = static_cast<size_t>(contador);
+        return contadorSinBase(c) - base[c];
+    }
+
+    ResumenHistograma etapa(Etapa etapa) {
+        std::lock_guard<std::mutex> lock(mutex);
+        size_t e = static_cast<size_t>(etapa);
+        ResumenHistograma resumen;
+        resumen.agregar(etapasRetiradas[e]);
+        for (const auto& b : buffers) resumen.agregar(b->etapas[e]);
+        return resumen;
+    }
+
+    void reiniciarContadores() {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (size_t c = 0; c < NUM_CONTADORES; c++) base[c] = contadorSinBase(c);
+    }
+
+    // Contadores y, por etapa, cantidad, promedio, percentiles y las casillas no vacias
+    // del histograma como pares [ns, cantidad]
+    void escribirJSON(std::ostream& out) {
+        out << "{\n  \"contadores\": {";
+        for (size_t c = 0; c < NUM_CONTADORES; c++) {
+            out << (c > 0 ? ", " : "") << "\"" << nombreContador(static_cast<Contador>(c)) << "\": " << contador(static_cast<Contador>(c));
+        }
+        out << "},\n  \"etapas\": [\n";
+        for (size_t e = 0; e < NUM_ETAPAS; e++) {
+            ResumenHistograma r = etapa(static_cast<Etapa>(e));
+            out << "    {\"etapa\": \"" << nombreEtapa(static_cast<Etapa>(e)) << "\", \"cantidad\": " << r.total
+                << ", \"promedio_ns\": " << static_cast<uint64_t>(r.promedio()) << ", \"p50_ns\": " << r.percentil(0.50)
+                << ", \"p95_ns\": " << r.percentil(0.95) << ", \"p99_ns\": " << r.percentil(0.99) << ", \"max_ns\": " << r.maximo
+                << ", \"histograma\": [";
+            bool primera = true;
+            for (uint32_t c = 0; c < Histograma::CASILLAS; c++) {
+                if (r.cuentas[c] == 0) continue;
+                out << (primera ? "" : ", ") << "[" << Histograma::representante(c) << ", " << r.cuentas[c] << "]";
+                primera = false;
+            }
+            out << "]}" << (e + 1 < NUM_ETAPAS ? "," : "") << "\n";
+        }
+        out << "  ]\n}\n";
+    }
+};
+
+// Mide una etapa desde la construccion hasta detener() o el destructor
+class CronometroEtapa {
+private:
+    Etapa etapa;
+    bool activo;
+    std::chrono::steady_clock::time_point inicio;
+
+public:
+    explicit CronometroEtapa(Etapa _etapa) : etapa(_etapa), activo(RegistroMetricas::global().activas.load(std::memory_order_relaxed)) {
+        if (activo) inicio = std::chrono::steady_clock::now();
+    }
+
+    ~CronometroEtapa() {
+        detener();
+    }
+
+    void detener() {
+        if (!activo) return;
+        activo = false;
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - inicio).count();
+        RegistroMetricas::global().registrar(etapa, static_cast<uint64_t>(ns));
+    }
+};
+
+#endif // METRICAS_H
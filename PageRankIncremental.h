@@ -0,0 +1,323 @@
+#ifndef PAGERANKINCREMENTAL_H
+#define PAGERANKINCREMENTAL_H
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "Grafo.h"
+
+// Parametros del mantenimiento incremental
+struct OpcionesPageRankIncremental {
+    double d = 0.85;
+    double tolerancia = 1e-6; // cota del error L1 del PR normalizado que se tolera
+    bool ponderado = false;  // igual que en OpcionesPageRank
+    // Trabajo maximo de cada actualizacion, independiente del tamano del grafo
+    uint64_t presupuestoEmpujes = 4096; // aristas que pueden recorrer los empujes
+    int maxBarridos = 4;                // recorridos completos del grafo (Jacobi)
+};
+
+// PageRank mantenido con empujes de residuo (Gauss-Southwell) a medida que el grafo crece.
+// Se guarda el PR sin normalizar x (suma N) y el residuo r = (1 - d) + d * C / N + d * P^T x - x
+// de cada nodo, donde C es la suma de x en los nodos sin aristas (colgantes): como en
+// calcularPageRank, su masa se reparte entre todos los nodos como un solo escalar. El PR
+// exacto es x + (I - d G^T)^-1 r, asi que empujar el residuo de un nodo (pasarlo a x y
+// repartir d * r / salida a sus vecinos, o d * r / N a todos si es colgante) acerca x al
+// valor exacto sin recalcular todo. Lo que se reparte a todos se acumula en 'uniforme' y
+// se suma a cada residuo recien al empezar la siguiente ronda de empujes.
+// Cuando llegan aristas nuevas solo cambian los residuos de los vecinos de los nodos cuya
+// salida cambio. El error L1 del PR normalizado es a lo sumo sum|r| / (N (1 - d)) (ver
+// cotaError): mientras esa cota no pase la tolerancia no se hace nada mas (O(grado) por
+// consulta), y cuando la pasa se empujan los residuos mas grandes (umbral que se divide por
+// dos en cada ronda) hasta dejarla en la mitad. Si el cambio no es local y los empujes
+// gastan su presupuesto, se sigue con a lo sumo maxBarridos barridos de Jacobi que parten
+// del x actual: en este grafo no dirigido convergen mucho mas rapido que los empujes,
+// que solo reducen el residuo un factor d por salto. El residuo que queda al agotar el
+// presupuesto se arrastra a la siguiente actualizacion (cotaError puede pasar la
+// tolerancia mientras tanto), asi ninguna consulta paga un recalculo completo.
+// Una consulta con un solo resultado deja un nodo colgante en el grafo de co-relevancia.
+class PageRankIncremental {
+private:
+    const Grafo& grafo;
+    OpcionesPageRankIncremental opciones;
+    std::vector<double> x;        // PR sin normalizar, por id de nodo
+    std::vector<double> r;        // residuo de cada nodo
+    std::vector<double> salida;   // salida (grado o suma de pesos) con la que se calculo r
+    std::vector<bool> enCola;
+    std::deque<uint32_t> cola;
+    double sumaResiduos = 0.0;    // sum|r|, al dia con cada cambio de r
+    double uniforme = 0.0;        // residuo pendiente de sumar a todos los nodos
+    double colgante = 0.0;        // C: suma de x en los nodos sin salida
+    uint64_t empujes = 0;
+    uint64_t barridos = 0;
+
+    double peso(uint64_t e) const {
+        return opciones.ponderado ? grafo.pesos[e] : 1.0;
+    }
+
+    double salidaActual(uint32_t u) const {
+        if (!opciones.ponderado) return grafo.grado(u);
+        double suma = 0.0;
+        for (uint64_t e = grafo.desplazamientos[u]; e < grafo.finVecinos(u); e++) suma += grafo.pesos[e];
+        return suma;
+    }
+
+    // Residuo real del nodo, con la parte uniforme pendiente
+    double residuo(uint32_t u) const {
+        return r[u] + uniforme;
+    }
+
+    // Trabajo de empujar un nodo: su salida, o 1 si es colgante (solo cambia 'uniforme')
+    double costo(uint32_t u) const {
+        return salida[u] > 0 ? salida[u] : 1.0;
+    }
+
+    // Cota de sum|r + uniforme| sin recorrer los nodos
+    double cotaResiduos() const {
+        return sumaResiduos + static_cast<double>(x.size()) * std::fabs(uniforme);
+    }
+
+    // Suma la parte uniforme a cada residuo y recalcula sum|r| desde cero (sin el redondeo acumulado)
+    void consolidar() {
+        sumaResiduos = 0.0;
+        for (double& residuo : r) {
+            residuo += uniforme;
+            sumaResiduos += std::fabs(residuo);
+        }
+        uniforme = 0.0;
+    }
+
+    void sumarResiduo(uint32_t v, double delta) {
+        double anterior = std::fabs(r[v]);
+        r[v] += delta;
+        sumaResiduos += std::fabs(r[v]) - anterior;
+    }
+
+    // sum|r| maximo para respetar la tolerancia
+    double limiteResiduos() const {
+        return opciones.tolerancia * static_cast<double>(x.size()) * (1.0 - opciones.d);
+    }
+
+    // Se empuja un nodo si su residuo supera umbral * salida: el trabajo de un empuje es
+    // proporcional al grado, asi cada empuje saca al menos umbral * (1 - d) de residuo
+    // por arista recorrida
+    void encolar(uint32_t u, double umbral) {
+        if (!enCola[u] && std::fabs(residuo(u)) > umbral * costo(u)) {
+            enCola[u] = true;
+            cola.push_back(u);
+        }
+    }
+
+    void crecer(size_t n) {
+        size_t anterior = x.size();
+        if (n <= anterior) return;
+        // La masa colgante se reparte ahora entre mas nodos
+        if (anterior > 0) uniforme += opciones.d * colgante * (1.0 / n - 1.0 / anterior);
+        while (x.size() < n) {
+            // x = 0: todo el valor base queda como residuo
+            double base = 1.0 - opciones.d + opciones.d * colgante / n - uniforme;
+            x.push_back(0.0);
+            r.push_back(base);
+            sumaResiduos += std::fabs(base);
+            salida.push_back(0.0);
+            enCola.push_back(false);
+        }
+    }
+
+    // Empuja residuos hasta que ningun nodo en la cola supera el umbral o se gasta el
+    // presupuesto de aristas recorridas (que se descuenta)
+    uint64_t propagar(double umbral, uint64_t& presupuesto) {
+        uint64_t hechos = 0;
+        while (!cola.empty() && presupuesto > 0) {
+            uint32_t u = cola.front();
+            cola.pop_front();
+            enCola[u] = false;
+            if (std::fabs(residuo(u)) <= umbral * costo(u)) continue;
+            double empujado = residuo(u);
+            x[u] += empujado;
+            sumarResiduo(u, -empujado);
+            if (salida[u] == 0) {
+                colgante += empujado;
+                uniforme += opciones.d * empujado / static_cast<double>(x.size());
+                presupuesto -= std::min<uint64_t>(presupuesto, 1);
+                hechos++;
+                continue;
+            }
+            double aporte = opciones.d * empujado / salida[u];
+            for (uint64_t e = grafo.desplazamientos[u]; e < grafo.finVecinos(u); e++) {
+                uint32_t v = grafo.vecinos[e];
+                sumarResiduo(v, aporte * peso(e));
+                encolar(v, umbral);
+            }
+            presupuesto -= std::min<uint64_t>(presupuesto, grafo.grado(u));
+            hechos++;
+        }
+        while (!cola.empty()) {
+            enCola[cola.front()] = false;
+            cola.pop_front();
+        }
+        return hechos;
+    }
+
+    // Barridos de Jacobi desde el x actual hasta que sum|r| <= objetivo o se hicieron
+    // 'maximo': y = (1 - d) + d P^T x, r = y - x (residuo exacto de x); si no alcanza y
+    // queda presupuesto, x = y y se repite. El ultimo barrido deja x con su residuo exacto.
+    void barrer(double objetivo, int maximo) {
+        size_t N = x.size();
+        std::vector<double> aporte(N);
+        std::vector<double> y(N);
+        for (int iteracion = 1; iteracion <= maximo; iteracion++) {
+            // El PR sin normalizar suma N; reescalar quita el error en esa direccion, que
+            // Jacobi solo reduce un factor d por barrido
+            double masa = 0.0;
+            for (double valor : x) masa += valor;
+            double escala = masa > 0 ? static_cast<double>(N) / masa : 1.0;
+            colgante = 0.0;
+            for (uint32_t u = 0; u < N; u++) {
+                x[u] *= escala;
+                aporte[u] = salida[u] > 0 ? opciones.d * x[u] / salida[u] : 0.0;
+                if (salida[u] == 0) colgante += x[u];
+            }
+            double base = 1.0 - opciones.d + opciones.d * colgante / static_cast<double>(N);
+            uniforme = 0.0;
+            sumaResiduos = 0.0;
+            for (uint32_t v = 0; v < N; v++) {
+                double suma = base;
+                for (uint64_t e = grafo.desplazamientos[v]; e < grafo.finVecinos(v); e++) {
+                    suma += aporte[grafo.vecinos[e]] * peso(e);
+                }
+                y[v] = suma;
+                r[v] = suma - x[v];
+                sumaResiduos += std::fabs(r[v]);
+            }
+            barridos++;
+            if (sumaResiduos <= objetivo || iteracion == maximo) return;
+            x.swap(y);
+            colgante = 0.0;
+            for (uint32_t u = 0; u < N; u++) {
+                if (salida[u] == 0) colgante += x[u];
+            }
+        }
+    }
+
+    // Si la cota de error paso la tolerancia, empuja por rondas con umbral decreciente
+    // hasta dejar sum|r| en la mitad del limite (o barre si el cambio no es local), dentro
+    // del presupuesto de la actualizacion. Devuelve cuantos empujes hizo.
+    uint64_t ajustar() {
+        double limite = limiteResiduos();
+        if (cotaResiduos() <= limite) return 0;
+        uint64_t presupuesto = opciones.presupuestoEmpujes;
+        uint64_t hechos = 0;
+        double umbral = 0.0;
+        for (uint32_t u = 0; u < x.size(); u++) umbral = std::max(umbral, std::fabs(residuo(u)) / costo(u));
+        while (umbral > 0) {
+            consolidar();
+            if (sumaResiduos <= limite / 2) break;
+            umbral /= 2;
+            for (uint32_t u = 0; u < x.size(); u++) encolar(u, umbral);
+            hechos += propagar(umbral, presupuesto);
+            if (presupuesto == 0) {
+                if (opciones.maxBarridos > 0) barrer(limite / 2, opciones.maxBarridos);
+                break;
+            }
+        }
+        empujes += hechos;
+        return hechos;
+    }
+
+public:
+    // Parte de un PageRank normalizado por id de nodo (por ejemplo, el de calcularPageRank
+    // sobre el mismo grafo finalizado) y calcula sus residuos exactos con un recorrido.
+    PageRankIncremental(const Grafo& _grafo, const std::vector<double>& pagerank, const OpcionesPageRankIncremental& _opciones = OpcionesPageRankIncremental())
+        : grafo(_grafo), opciones(_opciones) {
+        size_t N = grafo.numNodos();
+        x.assign(N, 0.0);
+        for (size_t u = 0; u < N && u < pagerank.size(); u++) x[u] = pagerank[u] * N;
+        enCola.assign(N, false);
+        salida.resize(N);
+        for (uint32_t u = 0; u < N; u++) {
+            salida[u] = salidaActual(u);
+            if (salida[u] == 0) colgante += x[u];
+        }
+        r.assign(N, 1.0 - opciones.d + (N > 0 ? opciones.d * colgante / N : 0.0));
+        for (uint32_t v = 0; v < N; v++) {
+            r[v] -= x[v];
+            for (uint64_t e = grafo.desplazamientos[v]; e < grafo.finVecinos(v); e++) {
+                uint32_t u = grafo.vecinos[e]; // no dirigido: u -> v con el mismo peso
+                if (salida[u] > 0) r[v] += opciones.d * x[u] * peso(e) / salida[u];
+            }
+        }
+        for (double residuo : r) sumaResiduos += std::fabs(residuo);
+        ajustar();
+    }
+
+    // Incorpora aristas que ya se agregaron al grafo y se finalizaron; cada par de 'pares'
+    // sumo 1 al peso de su arista (puede repetirse). Devuelve cuantos empujes hicieron falta.
+    uint64_t aristasAgregadas(const std::vector<std::pair<uint32_t, uint32_t>>& pares) {
+        crecer(grafo.numNodos());
+
+        // Peso que agrego cada arista dirigida
+        std::unordered_map<uint64_t, uint32_t> delta;
+        for (const auto& par : pares) {
+            delta[(static_cast<uint64_t>(par.first) << 32) | par.second]++;
+            delta[(static_cast<uint64_t>(par.second) << 32) | par.first]++;
+        }
+        std::vector<uint32_t> extremos;
+        for (const auto& par : pares) {
+            extremos.push_back(par.first);
+            extremos.push_back(par.second);
+        }
+        std::sort(extremos.begin(), extremos.end());
+        extremos.erase(std::unique(extremos.begin(), extremos.end()), extremos.end());
+
+        // Solo cambian los aportes de los nodos cuya salida cambio: de d x[u] w / salida
+        // a d x[u] w' / salida' para cada vecino (sin ponderar, un peso mayor en una arista
+        // que ya existia no cambia nada)
+        for (uint32_t u : extremos) {
+            double salidaNueva = salidaActual(u);
+            if (salidaNueva == salida[u]) continue;
+            if (salida[u] == 0) {
+                // Deja de ser colgante: su masa ya no se reparte entre todos
+                colgante -= x[u];
+                uniforme -= opciones.d * x[u] / static_cast<double>(x.size());
+            }
+            for (uint64_t e = grafo.desplazamientos[u]; e < grafo.finVecinos(u); e++) {
+                uint32_t v = grafo.vecinos[e];
+                auto it = delta.find((static_cast<uint64_t>(u) << 32) | v);
+                uint32_t agregado = it == delta.end() ? 0 : it->second;
+                double pesoNuevo = peso(e);
+                double pesoAnterior = opciones.ponderado ? pesoNuevo - agregado : (grafo.pesos[e] == agregado ? 0.0 : 1.0);
+                double antes = salida[u] > 0 ? pesoAnterior / salida[u] : 0.0;
+                sumarResiduo(v, opciones.d * x[u] * (pesoNuevo / salidaNueva - antes));
+            }
+            salida[u] = salidaNueva;
+        }
+        return ajustar();
+    }
+
+    // PR normalizado del nodo (suma 1 sobre todos los nodos)
+    double valor(uint32_t u) const {
+        return x[u] / static_cast<double>(x.size());
+    }
+
+    size_t size() const {
+        return x.size();
+    }
+
+    // Cota del error L1 del PR normalizado respecto del exacto
+    double cotaError() const {
+        return x.empty() ? 0.0 : cotaResiduos() / (static_cast<double>(x.size()) * (1.0 - opciones.d));
+    }
+
+    uint64_t empujesTotales() const {
+        return empujes;
+    }
+
+    uint64_t barridosTotales() const {
+        return barridos;
+    }
+};
+
+#endif // PAGERANKINCREMENTAL_H
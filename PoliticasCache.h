@@ -0,0 +1,545 @@
+#ifndef POLITICASCACHE_H
+#define POLITICASCACHE_H
+#include <algorithm>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "LRUCache.h"
+
+// Politicas de desalojo alternativas a LRU, todas con capacidad en bytes:
+//  - ARC: dos listas (vistas una vez / varias veces) y dos historiales fantasma que
+//    ajustan el tamano objetivo de cada una.
+//  - S3-FIFO: una FIFO chica (10%) que filtra las consultas que aparecen una sola vez,
+//    una FIFO principal con reinsercion por frecuencia y un historial fantasma.
+//  - W-TinyLFU: una ventana LRU (1%) y una SLRU principal; para entrar a la principal
+//    un candidato tiene que ser mas frecuente que la victima segun un count-min sketch.
+
+struct HashClaveCache {
+    template <typename Clave>
+    size_t operator()(const Clave& key) const { return static_cast<size_t>(hashClave(key)); }
+};
+
+// Base de las politicas con colas: cada entrada se guarda una vez en una tabla hash y se
+// ubica en una de varias colas (listas de claves, la mas reciente al frente).
+template <typename Valor, typename Clave>
+class CacheColas : public CacheBase<Valor, Clave> {
+protected:
+    typedef std::list<Clave> Cola;
+    struct Entrada {
+        Valor valor;
+        size_t bytes;
+        uint8_t cola;
+        uint8_t frecuencia;
+        typename Cola::iterator pos;
+    };
+    std::unordered_map<Clave, Entrada, HashClaveCache> entradas;
+    std::vector<Cola> colas;
+    std::vector<size_t> bytesCola;
+    size_t bytes = 0;
+    size_t maxBytes;
+
+    // Costo de una entrada: la entrada, el nodo de la tabla, el nodo de la cola y la memoria dinamica
+    static size_t bytesEntrada(const Clave& key, const Valor& value) {
+        return sizeof(Entrada) + 2 * sizeof(Clave) + 4 * sizeof(void*) + bytesDinamicos(key) + bytesDinamicos(value);
+    }
+
+    void agregar(const Clave& key, const Valor& value, size_t costo, uint8_t c) {
+        Entrada& e = entradas[key];
+        e.valor = value;
+        e.bytes = costo;
+        e.cola = c;
+        e.frecuencia = 0;
+        colas[c].push_front(key);
+        e.pos = colas[c].begin();
+        bytesCola[c] += costo;
+        bytes += costo;
+    }
+
+    void moverAlFrente(const Clave& key, Entrada& e, uint8_t c) {
+        colas[e.cola].erase(e.pos);
+        bytesCola[e.cola] -= e.bytes;
+        colas[c].push_front(key);
+        e.pos = colas[c].begin();
+        e.cola = c;
+        bytesCola[c] += e.bytes;
+    }
+
+    // Cambia el valor de una entrada existente ajustando los bytes
+    void actualizar(Entrada& e, const Valor& value, size_t costo) {
+        bytesCola[e.cola] += costo - e.bytes;
+        bytes += costo - e.bytes;
+        e.valor = value;
+        e.bytes = costo;
+    }
+
+    void quitar(const Clave& key) {
+        auto it = entradas.find(key);
+        colas[it->second.cola].erase(it->second.pos);
+        bytesCola[it->second.cola] -= it->second.bytes;
+        bytes -= it->second.bytes;
+        entradas.erase(it);
+    }
+
+    // Hooks de cada politica
+    virtual void alAcceder(const Clave& key, Entrada& e) = 0;
+    virtual void alFallar(const Clave&) {}
+    virtual void limpiarHistorial() {}
+
+public:
+    CacheColas(size_t _maxBytes, size_t numColas) : colas(numColas), bytesCola(numColas, 0), maxBytes(_maxBytes) {}
+
+    using CacheBase<Valor, Clave>::get;
+
+    bool get(const Clave& key, Valor& value) override {
+        auto it = entradas.find(key);
+        if (it == entradas.end()) {
+            alFallar(key);
+            return false;
+        }
+        alAcceder(key, it->second);
+        value = it->second.valor;
+        return true;
+    }
+
+    bool contains(const Clave& key) const override { return entradas.count(key) > 0; }
+    int getSize() const override { return static_cast<int>(entradas.size()); }
+    size_t getBytes() const override { return bytes; }
+    size_t getMaxBytes() const override { return maxBytes; }
+
+    // Claves de cada cola, de la mas reciente a la mas antigua
+    std::vector<Clave> getAllKeys() const override {
+        std::vector<Clave> keys;
+        keys.reserve(entradas.size());
+        for (const Cola& cola : colas) keys.insert(keys.end(), cola.begin(), cola.end());
+        return keys;
+    }
+
+    void transformar(const std::function<void(Valor&)>& f) override {
+        for (auto& par : entradas) f(par.second.valor);
+    }
+
+    void clear() override {
+        entradas.clear();
+        for (Cola& cola : colas) cola.clear();
+        std::fill(bytesCola.begin(), bytesCola.end(), 0);
+        bytes = 0;
+        limpiarHistorial();
+    }
+};
+
+// Historial fantasma: claves desalojadas recientemente (sin valor), en orden FIFO
+template <typename Clave>
+class Fantasmas {
+private:
+    std::list<std::pair<Clave, size_t>> orden; // clave y bytes que ocupaba
+    std::unordered_map<Clave, typename std::list<std::pair<Clave, size_t>>::iterator, HashClaveCache> posiciones;
+
+public:
+    size_t bytes = 0;
+
+    void agregar(const Clave& key, size_t b) {
+        orden.emplace_front(key, b);
+        posiciones[key] = orden.begin();
+        bytes += b;
+    }
+
+    bool contiene(const Clave& key) const { return posiciones.count(key) > 0; }
+
+    void quitar(const Clave& key) {
+        auto it = posiciones.find(key);
+        if (it == posiciones.end()) return;
+        bytes -= it->second->second;
+        orden.erase(it->second);
+        posiciones.erase(it);
+    }
+
+    void quitarMasAntiguo() {
+        if (orden.empty()) return;
+        quitar(orden.back().first);
+    }
+
+    size_t size() const { return orden.size(); }
+    bool empty() const { return orden.empty(); }
+
+    void clear() {
+        orden.clear();
+        posiciones.clear();
+        bytes = 0;
+    }
+};
+
+// ---------- ARC ----------
+
+template <typename Valor, typename Clave>
+class CacheARC : public CacheColas<Valor, Clave> {
+private:
+    typedef CacheColas<Valor, Clave> Base;
+    typedef typename Base::Entrada Entrada;
+    enum { T1 = 0, T2 = 1 }; // vistas una vez / mas de una vez
+    Fantasmas<Clave> b1, b2;
+    double objetivoT1 = 0.0; // bytes objetivo de T1 (p en el paper)
+
+    void alAcceder(const Clave& key, Entrada& e) override {
+        this->moverAlFrente(key, e, T2);
+    }
+
+    void limpiarHistorial() override {
+        b1.clear();
+        b2.clear();
+        objetivoT1 = 0.0;
+    }
+
+    // REPLACE: pasa entradas de T1 o T2 a su historial hasta que entren 'costo' bytes
+    int reemplazar(size_t costo, bool enB2) {
+        int desalojados = 0;
+        while (this->bytes + costo > this->maxBytes && !this->entradas.empty()) {
+            double t1 = static_cast<double>(this->bytesCola[T1]);
+            bool deT1 = !this->colas[T1].empty() &&
+                        (t1 > objetivoT1 || (enB2 && t1 >= objetivoT1) || this->colas[T2].empty());
+            Clave key = this->colas[deT1 ? T1 : T2].back();
+            size_t b = this->entradas[key].bytes;
+            this->quitar(key);
+            (deT1 ? b1 : b2).agregar(key, b);
+            desalojados++;
+        }
+        return desalojados;
+    }
+
+public:
+    CacheARC(size_t maxBytes) : Base(maxBytes, 2) {}
+
+    const char* politica() const override { return "arc"; }
+
+    int put(const Clave& key, const Valor& value) override {
+        size_t costo = Base::bytesEntrada(key, value);
+        auto it = this->entradas.find(key);
+        if (it != this->entradas.end()) {
+            if (costo > this->maxBytes) {
+                this->quitar(key);
+                return 1;
+            }
+            this->actualizar(it->second, value, costo);
+            this->moverAlFrente(key, it->second, T2);
+            return reemplazar(0, false);
+        }
+        if (costo > this->maxBytes) return 0;
+
+        double maximo = static_cast<double>(this->maxBytes);
+        if (b1.contiene(key)) {
+            // Fantasma de T1: T1 era demasiado chica
+            double delta = std::max(1.0, static_cast<double>(b2.bytes) / std::max<size_t>(b1.bytes, 1)) * costo;
+            objetivoT1 = std::min(maximo, objetivoT1 + delta);
+            b1.quitar(key);
+            int desalojados = reemplazar(costo, false);
+            this->agregar(key, value, costo, T2);
+            return desalojados;
+        }
+        if (b2.contiene(key)) {
+            // Fantasma de T2: T2 era demasiado chica
+            double delta = std::max(1.0, static_cast<double>(b1.bytes) / std::max<size_t>(b2.bytes, 1)) * costo;
+            objetivoT1 = std::max(0.0, objetivoT1 - delta);
+            b2.quitar(key);
+            int desalojados = reemplazar(costo, true);
+            this->agregar(key, value, costo, T2);
+            return desalojados;
+        }
+
+        // Clave nueva: L1 = T1 + B1 no puede pasar la capacidad, y todo junto no puede pasar el doble
+        int desalojados = 0;
+        while (this->bytesCola[T1] + b1.bytes + costo > this->maxBytes && !b1.empty()) b1.quitarMasAntiguo();
+        while (this->bytesCola[T1] + costo > this->maxBytes && !this->colas[T1].empty()) {
+            this->quitar(this->colas[T1].back());
+            desalojados++;
+        }
+        while (this->bytes + b1.bytes + b2.bytes + costo > 2 * this->maxBytes && !b2.empty()) b2.quitarMasAntiguo();
+        desalojados += reemplazar(costo, false);
+        this->agregar(key, value, costo, T1);
+        return desalojados;
+    }
+};
+
+// ---------- S3-FIFO ----------
+
+template <typename Valor, typename Clave>
+class CacheS3FIFO : public CacheColas<Valor, Clave> {
+private:
+    typedef CacheColas<Valor, Clave> Base;
+    typedef typename Base::Entrada Entrada;
+    enum { CHICA = 0, PRINCIPAL = 1 };
+    static const uint8_t MAX_FRECUENCIA = 3;
+    Fantasmas<Clave> fantasmas;
+
+    void alAcceder(const Clave&, Entrada& e) override {
+        // FIFO: un hit solo sube la frecuencia, no mueve la entrada
+        if (e.frecuencia < MAX_FRECUENCIA) e.frecuencia++;
+    }
+
+    void limpiarHistorial() override { fantasmas.clear(); }
+
+    // Desaloja de la FIFO chica: lo accedido pasa a la principal, lo demas al historial
+    int desalojarChica() {
+        while (!this->colas[CHICA].empty()) {
+            Clave key = this->colas[CHICA].back();
+            Entrada& e = this->entradas[key];
+            if (e.frecuencia > 0) {
+                e.frecuencia = 0;
+                this->moverAlFrente(key, e, PRINCIPAL);
+                continue;
+            }
+            this->quitar(key);
+            fantasmas.agregar(key, 0);
+            // el historial recuerda tantas claves como entradas tiene la FIFO principal
+            while (fantasmas.size() > std::max<size_t>(this->colas[PRINCIPAL].size(), 1)) fantasmas.quitarMasAntiguo();
+            return 1;
+        }
+        return 0;
+    }
+
+    // Desaloja de la FIFO principal: lo accedido se reinserta con frecuencia - 1
+    int desalojarPrincipal() {
+        while (!this->colas[PRINCIPAL].empty()) {
+            Clave key = this->colas[PRINCIPAL].back();
+            Entrada& e = this->entradas[key];
+            if (e.frecuencia > 0) {
+                e.frecuencia--;
+                this->moverAlFrente(key, e, PRINCIPAL);
+                continue;
+            }
+            this->quitar(key);
+            return 1;
+        }
+        return 0;
+    }
+
+    int liberar(size_t costo) {
+        int desalojados = 0;
+        while (this->bytes + costo > this->maxBytes && !this->entradas.empty()) {
+            if (this->bytesCola[CHICA] >= this->maxBytes / 10 || this->colas[PRINCIPAL].empty()) {
+                desalojados += desalojarChica();
+            } else {
+                desalojados += desalojarPrincipal();
+            }
+        }
+        return desalojados;
+    }
+
+public:
+    CacheS3FIFO(size_t maxBytes) : Base(maxBytes, 2) {}
+
+    const char* politica() const override { return "s3fifo"; }
+
+    int put(const Clave& key, const Valor& value) override {
+        size_t costo = Base::bytesEntrada(key, value);
+        auto it = this->entradas.find(key);
+        if (it != this->entradas.end()) {
+            if (costo > this->maxBytes) {
+                this->quitar(key);
+                return 1;
+            }
+            this->actualizar(it->second, value, costo);
+            alAcceder(key, it->second);
+            return liberar(0);
+        }
+        if (costo > this->maxBytes) return 0;
+
+        int desalojados = liberar(costo);
+        if (fantasmas.contiene(key)) {
+            fantasmas.quitar(key);
+            this->agregar(key, value, costo, PRINCIPAL);
+        } else {
+            this->agregar(key, value, costo, CHICA);
+        }
+        return desalojados;
+    }
+};
+
+// ---------- W-TinyLFU ----------
+
+// Count-min sketch de 4 filas con contadores de 4 bits (saturan en 15), dos por byte.
+// Cada 'periodo' incrementos todos los contadores se dividen por 2, asi la frecuencia
+// envejece.
+class SketchFrecuencia {
+private:
+    static const int FILAS = 4;
+    std::vector<uint8_t> contadores; // el contador i esta en la mitad (i & 1) del byte i / 2
+    uint32_t bitsAncho;
+    size_t muestras = 0;
+    size_t periodo;
+
+    uint8_t contador(size_t i) const {
+        return (contadores[i >> 1] >> ((i & 1) * 4)) & 0x0F;
+    }
+
+    size_t indice(uint64_t h, int fila) const {
+        static const uint64_t semillas[FILAS] = {
+            0x9E3779B97F4A7C15ull, 0xC2B2AE3D27D4EB4Full, 0x165667B19E3779F9ull, 0xD6E8FEB86659FD93ull};
+        size_t ancho = size_t(1) << bitsAncho;
+        return fila * ancho + static_cast<size_t>((h * semillas[fila]) >> (64 - bitsAncho));
+    }
+
+public:
+    // 'ancho' se redondea a potencia de 2
+    SketchFrecuencia(size_t ancho) {
+        bitsAncho = 4;
+        while ((size_t(1) << bitsAncho) < ancho) bitsAncho++;
+        contadores.assign(FILAS * (size_t(1) << bitsAncho) / 2, 0);
+        periodo = 10 * (size_t(1) << bitsAncho);
+    }
+
+    void incrementar(uint64_t h) {
+        for (int f = 0; f < FILAS; f++) {
+            size_t i = indice(h, f);
+            if (contador(i) < 15) contadores[i >> 1] += static_cast<uint8_t>(1u << ((i & 1) * 4));
+        }
+        if (++muestras >= periodo) {
+            // Divide por 2 las dos mitades de cada byte a la vez (sin pasar bits de una a otra)
+            for (uint8_t& par : contadores) par = (par >> 1) & 0x77;
+            muestras /= 2;
+        }
+    }
+
+    uint8_t estimar(uint64_t h) const {
+        uint8_t minimo = 15;
+        for (int f = 0; f < FILAS; f++) minimo = std::min(minimo, contador(indice(h, f)));
+        return minimo;
+    }
+
+    void clear() {
+        std::fill(contadores.begin(), contadores.end(), 0);
+        muestras = 0;
+    }
+};
+
+template <typename Valor, typename Clave>
+class CacheWTinyLFU : public CacheColas<Valor, Clave> {
+private:
+    typedef CacheColas<Valor, Clave> Base;
+    typedef typename Base::Entrada Entrada;
+    enum { VENTANA = 0, PRUEBA = 1, PROTEGIDA = 2 };
+    SketchFrecuencia sketch;
+    size_t maxVentana;
+    size_t maxProtegida;
+
+    void alFallar(const Clave& key) override { sketch.incrementar(hashClave(key)); }
+
+    void alAcceder(const Clave& key, Entrada& e) override {
+        sketch.incrementar(hashClave(key));
+        if (e.cola == PRUEBA || e.cola == PROTEGIDA) {
+            this->moverAlFrente(key, e, PROTEGIDA);
+            // la protegida que se pasa de su parte devuelve sus menos recientes a prueba
+            while (this->bytesCola[PROTEGIDA] > maxProtegida && this->colas[PROTEGIDA].size() > 1) {
+                Clave ultima = this->colas[PROTEGIDA].back();
+                this->moverAlFrente(ultima, this->entradas[ultima], PRUEBA);
+            }
+        } else {
+            this->moverAlFrente(key, e, VENTANA);
+        }
+    }
+
+    void limpiarHistorial() override { sketch.clear(); }
+
+    // El candidato que sale de la ventana compite con la victima de la principal
+    int admitir(const Clave& candidato) {
+        int desalojados = 0;
+        this->moverAlFrente(candidato, this->entradas[candidato], PRUEBA);
+        uint8_t frecuencia = sketch.estimar(hashClave(candidato));
+        while (this->bytes > this->maxBytes) {
+            const Clave* victima = nullptr;
+            if (this->colas[PRUEBA].size() > 1) victima = &this->colas[PRUEBA].back();
+            else if (!this->colas[PROTEGIDA].empty()) victima = &this->colas[PROTEGIDA].back();
+            if (victima == nullptr || frecuencia <= sketch.estimar(hashClave(*victima))) {
+                this->quitar(candidato);
+                return desalojados + 1;
+            }
+            this->quitar(Clave(*victima));
+            desalojados++;
+        }
+        return desalojados;
+    }
+
+    // Desaloja sin admision (tras actualizar una entrada), sin tocar 'proteger'
+    int liberar(const Clave& proteger) {
+        int desalojados = 0;
+        while (this->bytes > this->maxBytes) {
+            int c = !this->colas[PRUEBA].empty() ? PRUEBA : (!this->colas[PROTEGIDA].empty() ? PROTEGIDA : VENTANA);
+            if (this->colas[c].back() == proteger) break;
+            this->quitar(Clave(this->colas[c].back()));
+            desalojados++;
+        }
+        return desalojados;
+    }
+
+public:
+    // El sketch supone entradas de al menos 64 bytes para dimensionarse
+    CacheWTinyLFU(size_t maxBytes)
+        : Base(maxBytes, 3), sketch(std::max<size_t>(64, maxBytes / 64)),
+          maxVentana(maxBytes / 100), maxProtegida((maxBytes - maxBytes / 100) * 8 / 10) {}
+
+    const char* politica() const override { return "tinylfu"; }
+
+    int put(const Clave& key, const Valor& value) override {
+        size_t costo = Base::bytesEntrada(key, value);
+        auto it = this->entradas.find(key);
+        if (it != this->entradas.end()) {
+            if (costo > this->maxBytes) {
+                this->quitar(key);
+                return 1;
+            }
+            this->actualizar(it->second, value, costo);
+            return liberar(key);
+        }
+        if (costo > this->maxBytes) return 0;
+
+        this->agregar(key, value, costo, VENTANA);
+        int desalojados = 0;
+        while (this->bytesCola[VENTANA] > maxVentana && !this->colas[VENTANA].empty()) {
+            desalojados += admitir(Clave(this->colas[VENTANA].back()));
+        }
+        return desalojados + liberar(key);
+    }
+};
+
+// ---------- seleccion ----------
+
+inline const std::vector<std::string>& nombresPoliticas() {
+    static const std::vector<std::string> nombres = {"lru", "arc", "s3fifo", "tinylfu"};
+    return nombres;
+}
+
+inline bool politicaValida(const std::string& nombre) {
+    const auto& nombres = nombresPoliticas();
+    return std::find(nombres.begin(), nombres.end(), nombre) != nombres.end();
+}
+
+// Interpreta una cantidad de bytes con sufijo opcional K, M o G (potencias de 1024)
+inline bool leerBytes(const std::string& texto, size_t& bytes) {
+    size_t usados = 0;
+    unsigned long long valor = 0;
+    try {
+        valor = std::stoull(texto, &usados);
+    } catch (...) {
+        return false;
+    }
+    std::string sufijo = texto.substr(usados);
+    if (sufijo == "K" || sufijo == "k") valor <<= 10;
+    else if (sufijo == "M" || sufijo == "m") valor <<= 20;
+    else if (sufijo == "G" || sufijo == "g") valor <<= 30;
+    else if (!sufijo.empty()) return false;
+    bytes = static_cast<size_t>(valor);
+    return true;
+}
+
+// Crea un cache con la politica pedida (LRU si el nombre no es valido)
+template <typename Valor, typename Clave>
+std::unique_ptr<CacheBase<Valor, Clave>> crearCache(const std::string& politica, size_t maxBytes) {
+    if (politica == "arc") return std::unique_ptr<CacheBase<Valor, Clave>>(new CacheARC<Valor, Clave>(maxBytes));
+    if (politica == "s3fifo") return std::unique_ptr<CacheBase<Valor, Clave>>(new CacheS3FIFO<Valor, Clave>(maxBytes));
+    if (politica == "tinylfu") return std::unique_ptr<CacheBase<Valor, Clave>>(new CacheWTinyLFU<Valor, Clave>(maxBytes));
+    return std::unique_ptr<CacheBase<Valor, Clave>>(new LRUCache<Valor, Clave>(maxBytes));
+}
+
+#endif // POLITICASCACHE_H
@@ -0,0 +1,94 @@
+#ifndef POOLHILOS_H
+#define POOLHILOS_H
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Pool de hilos persistente para bucles paralelos.
+// ejecutar(n, f) llama f(i) para cada i en [0, n) repartiendo los indices dinamicamente
+// entre los trabajadores (y el hilo que llama) y vuelve cuando todos terminaron.
+// Los hilos se crean una sola vez, asi que se puede llamar por cada lote sin costo extra.
+class PoolHilos {
+private:
+    std::vector<std::thread> trabajadores;
+    std::mutex mutex;
+    std::condition_variable hayTrabajo;
+    std::condition_variable terminado;
+    std::function<void(size_t)> tarea;
+    size_t total = 0;
+    std::atomic<size_t> siguiente{0};
+    unsigned activos = 0;     // trabajadores que no terminaron la tarea actual
+    uint64_t generacion = 0;  // cambia con cada llamada a ejecutar
+    bool detener = false;
+
+    void procesar() {
+        for (size_t i = siguiente.fetch_add(1); i < total; i = siguiente.fetch_add(1)) {
+            tarea(i);
+        }
+    }
+
+    void trabajar() {
+        uint64_t vista = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                hayTrabajo.wait(lock, [&]() { return detener || generacion != vista; });
+                if (detener) return;
+                vista = generacion;
+            }
+            procesar();
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (--activos == 0) terminado.notify_all();
+            }
+        }
+    }
+
+public:
+    // 'hilos' cuenta al hilo que llama: se crean hilos - 1 trabajadores
+    PoolHilos(unsigned hilos) {
+        for (unsigned h = 1; h < hilos; h++) {
+            trabajadores.emplace_back([this]() { trabajar(); });
+        }
+    }
+
+    ~PoolHilos() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            detener = true;
+        }
+        hayTrabajo.notify_all();
+        for (auto& t : trabajadores) t.join();
+    }
+
+    PoolHilos(const PoolHilos&) = delete;
+    PoolHilos& operator=(const PoolHilos&) = delete;
+
+    unsigned size() const { return static_cast<unsigned>(trabajadores.size()) + 1; }
+
+    void ejecutar(size_t n, const std::function<void(size_t)>& f) {
+        if (n == 0) return;
+        if (trabajadores.empty()) {
+            for (size_t i = 0; i < n; i++) f(i);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tarea = f;
+            total = n;
+            siguiente = 0;
+            activos = static_cast<unsigned>(trabajadores.size());
+            generacion++;
+        }
+        hayTrabajo.notify_all();
+        procesar();
+        std::unique_lock<std::mutex> lock(mutex);
+        terminado.wait(lock, [&]() { return activos == 0; });
+    }
+};
+
+#endif // POOLHILOS_H
@@ -0,0 +1,77 @@
+#ifndef RANKING_H
+#define RANKING_H
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <queue>
+#include <utility>
+#include <vector>
+
+// Parametros y formula de BM25
+struct BM25 {
+    double k1 = 1.2;  // saturacion de la frecuencia del termino
+    double b = 0.75;  // normalizacion por longitud del documento
+
+    // idf con suavizado (siempre positivo)
+    double idf(uint32_t df, uint32_t numDocs) const {
+        return std::log(1.0 + (numDocs - df + 0.5) / (df + 0.5));
+    }
+
+    double puntaje(uint32_t tf, uint32_t longitud, double longitudPromedio, double idfTermino) const {
+        double norm = k1 * (1.0 - b + b * (longitudPromedio > 0 ? longitud / longitudPromedio : 0.0));
+        return idfTermino * (tf * (k1 + 1.0)) / (tf + norm);
+    }
+};
+
+// Documento con su puntaje final
+struct DocPuntaje {
+    uint32_t docID;
+    double puntaje;
+};
+
+// Selecciona los k mejores documentos con un min-heap de tamano fijo: O(n log k)
+class TopK {
+private:
+    size_t k;
+    // Orden del heap: el peor candidato queda arriba (menor puntaje, y a igual puntaje el docID mayor)
+    struct Peor {
+        bool operator()(const DocPuntaje& a, const DocPuntaje& b) const {
+            if (a.puntaje != b.puntaje) return a.puntaje > b.puntaje;
+            return a.docID < b.docID;
+        }
+    };
+    std::priority_queue<DocPuntaje, std::vector<DocPuntaje>, Peor> heap;
+
+public:
+    TopK(size_t _k) : k(_k) {}
+
+    void agregar(uint32_t docID, double puntaje) {
+        if (k == 0) return;
+        if (heap.size() < k) {
+            heap.push({docID, puntaje});
+        } else if (Peor()({docID, puntaje}, heap.top())) {
+            heap.pop();
+            heap.push({docID, puntaje});
+        }
+    }
+
+    // Puntaje minimo para entrar al heap una vez lleno
+    double umbral() const {
+        return heap.size() < k ? 0.0 : heap.top().puntaje;
+    }
+
+    bool lleno() const { return heap.size() >= k; }
+    size_t size() const { return heap.size(); }
+
+    // Extrae los resultados ordenados de mayor a menor puntaje (vacia el heap)
+    std::vector<DocPuntaje> resultados() {
+        std::vector<DocPuntaje> out(heap.size());
+        for (size_t i = out.size(); i-- > 0;) {
+            out[i] = heap.top();
+            heap.pop();
+        }
+        return out;
+    }
+};
+
+#endif // RANKING_H
@@ -0,0 +1,134 @@
+#ifndef RANKINGESTATICO_H
+#define RANKINGESTATICO_H
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "Evaluacion.h"
+#include "Indice.h"
+#include "Ranking.h"
+
+// Como se combina el puntaje de texto (BM25) con el puntaje estatico (PageRank)
+enum class Fusion {
+    NINGUNA, // solo BM25
+    LINEAL,  // BM25 + peso * PageRank normalizado
+    RRF,     // reciprocal rank fusion del ranking de texto y el estatico
+};
+
+inline const char* nombreFusion(Fusion fusion) {
+    switch (fusion) {
+        case Fusion::LINEAL: return "lineal";
+        case Fusion::RRF: return "rrf";
+        default: return "ninguna";
+    }
+}
+
+// Interpreta "ninguna"/"lineal"/"rrf"; devuelve false si no es una fusion valida
+inline bool leerFusion(const std::string& texto, Fusion& fusion) {
+    if (texto == "ninguna") { fusion = Fusion::NINGUNA; return true; }
+    if (texto == "lineal") { fusion = Fusion::LINEAL; return true; }
+    if (texto == "rrf") { fusion = Fusion::RRF; return true; }
+    return false;
+}
+
+struct OpcionesFusion {
+    Fusion tipo = Fusion::NINGUNA;
+    double peso = 1.0;       // LINEAL: puntos de BM25 que suma el documento de mayor PageRank
+    double kRRF = 60.0;      // RRF: cada ranking aporta 1 / (kRRF + posicion)
+    size_t candidatos = 100; // RRF: largo de cada ranking que se fusiona
+};
+
+// Clave de cache de una consulta evaluada con fusion: no se mezcla con la de solo BM25
+inline uint64_t claveConFusion(uint64_t clave, const OpcionesFusion& opciones) {
+    if (opciones.tipo == Fusion::NINGUNA) return clave;
+    return (clave ^ (static_cast<uint64_t>(opciones.tipo) * 0x9E3779B97F4A7C15ull)) * 0x100000001b3ull;
+}
+
+// Orden estatico del indice: construir() renumera los documentos del indice base por
+// puntaje estatico decreciente (a igual puntaje, en el orden original), en el mismo
+// indice y sin copiarlo. Cada lista de postings queda ordenada por PageRank, asi que la
+// fusion lineal puede cortar el recorrido en cuanto el top-k queda fijo (ver
+// PriorEstatico) y los documentos de mayor PageRank que cumplen la consulta son los
+// primeros de la union o la interseccion. Los puntajes de BM25 no cambian: cada documento
+// conserva su longitud y cada termino su df.
+// Se construye una vez con el PageRank del arranque y no sigue al incremental.
+class IndiceEstatico {
+public:
+    const Indice* indice = nullptr;
+    std::vector<float> estatico; // docID -> puntaje / maximo, en [0, 1] y no creciente
+
+    // 'puntaje' tiene un valor por docID del indice base (0 para los que no tienen).
+    // Devuelve la permutacion docID anterior -> docID nuevo, para traducir lo que se
+    // guardo con la numeracion anterior (por ejemplo, los resultados del cache).
+    std::vector<uint32_t> construir(Indice& base, const std::vector<double>& puntaje) {
+        indice = &base;
+        uint32_t N = static_cast<uint32_t>(base.numDocumentos());
+        std::vector<uint32_t> original(N);
+        for (uint32_t d = 0; d < N; d++) original[d] = d;
+        auto valor = [&](uint32_t d) { return d < puntaje.size() ? puntaje[d] : 0.0; };
+        std::stable_sort(original.begin(), original.end(), [&](uint32_t a, uint32_t b) {
+            return valor(a) > valor(b);
+        });
+        double maximo = N > 0 ? valor(original[0]) : 0.0;
+        std::vector<uint32_t> nuevo(N);
+        estatico.resize(N);
+        for (uint32_t d = 0; d < N; d++) {
+            nuevo[original[d]] = d;
+            estatico[d] = maximo > 0 ? static_cast<float>(valor(original[d]) / maximo) : 0.0f;
+        }
+        base.renumerar(nuevo);
+        return nuevo;
+    }
+
+    // Top-k de la consulta con la fusion dada
+    std::vector<DocPuntaje> evaluar(const BM25& bm25, const std::vector<std::string>& palabras, ModoConsulta modo, size_t k, const OpcionesFusion& opciones) const {
+        if (opciones.tipo == Fusion::LINEAL) {
+            return evaluarConsulta(*indice, bm25, palabras, modo, k, PriorEstatico{estatico.data(), opciones.peso});
+        }
+        if (opciones.tipo == Fusion::RRF) {
+            std::unordered_map<uint32_t, double> puntajes;
+            std::vector<DocPuntaje> texto = evaluarConsulta(*indice, bm25, palabras, modo, opciones.candidatos);
+            for (size_t i = 0; i < texto.size(); i++) puntajes[texto[i].docID] += 1.0 / (opciones.kRRF + i + 1);
+            std::vector<uint32_t> porEstatico = primerosPorEstatico(palabras, modo, opciones.candidatos);
+            for (size_t i = 0; i < porEstatico.size(); i++) puntajes[porEstatico[i]] += 1.0 / (opciones.kRRF + i + 1);
+            // A igual puntaje (frecuente en RRF) gana el docID menor, el de mayor PageRank
+            return seleccionarTopK(puntajes, k);
+        }
+        return evaluarConsulta(*indice, bm25, palabras, modo, k);
+    }
+
+private:
+    // Los primeros n documentos que cumplen la consulta en orden de docID, es decir de
+    // mayor a menor PageRank; se detiene en el primero sin puntaje estatico
+    std::vector<uint32_t> primerosPorEstatico(const std::vector<std::string>& palabras, ModoConsulta modo, size_t n) const {
+        std::vector<uint32_t> docs;
+        if (modo == ModoConsulta::AND) {
+            for (uint32_t docID : intersectarPalabras(*indice, palabras)) {
+                if (docs.size() >= n || estatico[docID] <= 0) break;
+                docs.push_back(docID);
+            }
+            return docs;
+        }
+        std::vector<CursorPostings> cursores;
+        for (const std::string& palabra : palabras) {
+            CursorPostings cursor = indice->buscar(palabra);
+            if (cursor.size() > 0) cursores.push_back(cursor);
+        }
+        while (docs.size() < n) {
+            uint32_t menor = UINT32_MAX;
+            for (const auto& cursor : cursores) {
+                if (!cursor.fin()) menor = std::min(menor, cursor.docID());
+            }
+            if (menor == UINT32_MAX || estatico[menor] <= 0) break;
+            docs.push_back(menor);
+            for (auto& cursor : cursores) {
+                if (!cursor.fin() && cursor.docID() == menor) cursor.siguiente();
+            }
+        }
+        return docs;
+    }
+};
+
+#endif // RANKINGESTATICO_H
@@ -0,0 +1,163 @@
+#ifndef STOPWORDS_H
+#define STOPWORDS_H
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+// Conjunto de stopwords con hash perfecto minimo (hash and displace), armado al cargar.
+// Las palabras se reparten en cubetas por su hash; cada cubeta recibe un desplazamiento
+// elegido para que todas sus palabras caigan en casillas libres de una tabla de n casillas
+// (n = cantidad de stopwords). Una consulta cuesta un hash, dos lecturas y una sola
+// comparacion de strings, sin importar cuantas stopwords haya. Antes del hash se descarta
+// por longitud: la mayoria de los terminos del corpus no mide lo mismo que ninguna stopword.
+class Stopwords {
+private:
+    std::vector<std::string> palabras;       // en el orden del archivo, sin repetir
+    std::vector<uint32_t> desplazamientos;   // uno por cubeta
+    std::vector<uint32_t> casillas;          // indice en 'palabras' de cada casilla
+    uint64_t longitudes = 0;                 // bit min(longitud, 63) de cada stopword
+    uint64_t semilla = 0;
+
+    static uint64_t hashBase(std::string_view palabra) {
+        uint64_t h = 0xcbf29ce484222325ull;
+        for (char c : palabra) {
+            h ^= static_cast<unsigned char>(c);
+            h *= 0x100000001b3ull;
+        }
+        return h;
+    }
+
+    static uint64_t mezclar(uint64_t h) {
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ull;
+        h ^= h >> 33;
+        return h;
+    }
+
+    // Reduce 32 bits de hash a [0, n) con una multiplicacion en lugar de una division
+    static size_t reducir(uint64_t h32, size_t n) {
+        return static_cast<size_t>((h32 * n) >> 32);
+    }
+
+    size_t cubetaDe(uint64_t h) const {
+        return reducir(h >> 32, desplazamientos.size());
+    }
+
+    size_t casillaDe(uint64_t h, uint32_t desplazamiento) const {
+        return reducir(mezclar(h + semilla + desplazamiento * 0x9E3779B97F4A7C15ull) >> 32, casillas.size());
+    }
+
+    static uint64_t bitLongitud(size_t longitud) {
+        return uint64_t(1) << std::min<size_t>(longitud, 63);
+    }
+
+    // Intenta ubicar todas las palabras con la semilla actual
+    bool ubicar() {
+        size_t n = palabras.size();
+        desplazamientos.assign(std::max<size_t>(1, n / 2), 0);
+        casillas.assign(n, UINT32_MAX);
+        std::vector<std::vector<uint32_t>> cubetas(desplazamientos.size());
+        std::vector<uint64_t> hashes(n);
+        for (uint32_t i = 0; i < n; i++) {
+            hashes[i] = hashBase(palabras[i]);
+            cubetas[cubetaDe(hashes[i])].push_back(i);
+        }
+        // Las cubetas mas grandes primero, mientras la tabla esta casi vacia
+        std::vector<uint32_t> orden(cubetas.size());
+        for (uint32_t b = 0; b < orden.size(); b++) orden[b] = b;
+        std::sort(orden.begin(), orden.end(), [&](uint32_t a, uint32_t b) {
+            return cubetas[a].size() > cubetas[b].size();
+        });
+
+        std::vector<size_t> elegidas;
+        const uint32_t maxIntentos = static_cast<uint32_t>(std::min<size_t>(64 * n + 1024, UINT32_MAX));
+        for (uint32_t b : orden) {
+            if (cubetas[b].empty()) break;
+            bool ubicada = false;
+            for (uint32_t d = 0; d < maxIntentos && !ubicada; d++) {
+                elegidas.clear();
+                ubicada = true;
+                for (uint32_t i : cubetas[b]) {
+                    size_t c = casillaDe(hashes[i], d);
+                    if (casillas[c] != UINT32_MAX || std::find(elegidas.begin(), elegidas.end(), c) != elegidas.end()) {
+                        ubicada = false;
+                        break;
+                    }
+                    elegidas.push_back(c);
+                }
+                if (ubicada) {
+                    desplazamientos[b] = d;
+                    for (size_t k = 0; k < elegidas.size(); k++) casillas[elegidas[k]] = cubetas[b][k];
+                }
+            }
+            if (!ubicada) return false;
+        }
+        return true;
+    }
+
+public:
+    Stopwords() {}
+
+    explicit Stopwords(const std::vector<std::string>& lista) {
+        construir(lista);
+    }
+
+    // Arma el conjunto con las palabras dadas (se ignoran las repetidas y las vacias)
+    void construir(const std::vector<std::string>& lista) {
+        palabras.clear();
+        longitudes = 0;
+        std::unordered_set<std::string> vistas;
+        for (const auto& palabra : lista) {
+            if (palabra.empty() || !vistas.insert(palabra).second) continue;
+            palabras.push_back(palabra);
+            longitudes |= bitLongitud(palabra.size());
+        }
+        for (semilla = 0; !palabras.empty() && !ubicar(); semilla++) {}
+    }
+
+    // Carga un archivo con una stopword por linea, de cualquier tamano
+    bool cargar(const std::string& archivo) {
+        std::ifstream entrada(archivo);
+        if (!entrada.is_open()) {
+            std::cerr << "❌ Error al abrir el archivo de stopwords" << std::endl;
+            construir({});
+            return false;
+        }
+        std::vector<std::string> lista;
+        std::string linea;
+        while (std::getline(entrada, linea)) {
+            if (!linea.empty() && linea.back() == '\r') linea.pop_back();
+            lista.push_back(linea);
+        }
+        construir(lista);
+        return true;
+    }
+
+    bool contiene(std::string_view palabra) const {
+        if (palabras.empty() || !(longitudes & bitLongitud(palabra.size()))) return false;
+        uint64_t h = hashBase(palabra);
+        return palabras[casillas[casillaDe(h, desplazamientos[cubetaDe(h)])]] == palabra;
+    }
+
+    bool operator()(std::string_view palabra) const {
+        return contiene(palabra);
+    }
+
+    // Stopwords en el orden en que se cargaron
+    const std::vector<std::string>& lista() const {
+        return palabras;
+    }
+
+    size_t size() const {
+        return palabras.size();
+    }
+};
+
+#endif // STOPWORDS_H
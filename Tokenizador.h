@@ -0,0 +1,143 @@
+#ifndef TOKENIZADOR_H
+#define TOKENIZADOR_H
+#include <cstddef>
+#include <string>
+#include <string_view>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Archivo mapeado en memoria de solo lectura (mmap / MapViewOfFile)
+class ArchivoMapeado {
+private:
+    const char* datos = nullptr;
+    size_t tamano = 0;
+#ifdef _WIN32
+    HANDLE archivo = INVALID_HANDLE_VALUE;
+    HANDLE mapeo = nullptr;
+#endif
+
+public:
+    ArchivoMapeado() {}
+    ArchivoMapeado(const ArchivoMapeado&) = delete;
+    ArchivoMapeado& operator=(const ArchivoMapeado&) = delete;
+
+    ~ArchivoMapeado() {
+        cerrar();
+    }
+
+    // Mapea el archivo completo. Devuelve false si no se pudo abrir.
+    bool abrir(const std::string& ruta) {
+        cerrar();
+#ifdef _WIN32
+        archivo = CreateFileA(ruta.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (archivo == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(archivo, &size)) { cerrar(); return false; }
+        tamano = static_cast<size_t>(size.QuadPart);
+        if (tamano == 0) return true;
+        mapeo = CreateFileMappingA(archivo, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapeo == nullptr) { cerrar(); return false; }
+        datos = static_cast<const char*>(MapViewOfFile(mapeo, FILE_MAP_READ, 0, 0, 0));
+        if (datos == nullptr) { cerrar(); return false; }
+#else
+        int fd = ::open(ruta.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0) { ::close(fd); return false; }
+        tamano = static_cast<size_t>(st.st_size);
+        if (tamano > 0) {
+            void* p = mmap(nullptr, tamano, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) { ::close(fd); tamano = 0; return false; }
+            madvise(p, tamano, MADV_SEQUENTIAL);
+            datos = static_cast<const char*>(p);
+        }
+        ::close(fd); // el mapeo sigue valido despues de cerrar el descriptor
+#endif
+        return true;
+    }
+
+    void cerrar() {
+#ifdef _WIN32
+        if (datos != nullptr) UnmapViewOfFile(datos);
+        if (mapeo != nullptr) CloseHandle(mapeo);
+        if (archivo != INVALID_HANDLE_VALUE) CloseHandle(archivo);
+        mapeo = nullptr;
+        archivo = INVALID_HANDLE_VALUE;
+#else
+        if (datos != nullptr) munmap(const_cast<char*>(datos), tamano);
+#endif
+        datos = nullptr;
+        tamano = 0;
+    }
+
+    const char* data() const { return datos; }
+    size_t size() const { return tamano; }
+    std::string_view vista() const { return std::string_view(datos, tamano); }
+};
+
+// Tokenizador en sitio del formato del corpus: "http|| host|| ... texto".
+// Los tokens se entregan como string_view sobre el texto original; los terminos
+// se pasan a minusculas en un buffer reutilizable, sin reservar memoria por token.
+class Tokenizador {
+public:
+    static bool esEspacio(char c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+    }
+
+    static char aMinuscula(char c) {
+        return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+
+    // Un segmento de URL es un token terminado en "||"
+    static bool esSegmentoUrl(std::string_view token) {
+        return token.size() >= 2 && token[token.size() - 2] == '|' && token[token.size() - 1] == '|';
+    }
+
+    // Llama alLinea(std::string_view) por cada linea no vacia del texto
+    template <typename F>
+    static void recorrerLineas(std::string_view texto, F alLinea) {
+        size_t pos = 0;
+        while (pos < texto.size()) {
+            size_t salto = texto.find('\n', pos);
+            if (salto == std::string_view::npos) salto = texto.size();
+            if (salto > pos) alLinea(texto.substr(pos, salto - pos));
+            pos = salto + 1;
+        }
+    }
+
+    // Llama alToken(std::string_view) por cada token separado por espacios
+    template <typename F>
+    static void recorrerTokens(std::string_view linea, F alToken) {
+        const char* p = linea.data();
+        const char* fin = p + linea.size();
+        while (p < fin) {
+            while (p < fin && esEspacio(*p)) p++;
+            const char* inicio = p;
+            while (p < fin && !esEspacio(*p)) p++;
+            if (p > inicio) alToken(std::string_view(inicio, static_cast<size_t>(p - inicio)));
+        }
+    }
+
+    // Separa una linea en segmentos de URL (alUrl) y terminos en minusculas (alTermino).
+    // El termino entregado vive en 'buffer' y solo es valido durante la llamada.
+    template <typename FUrl, typename FTermino>
+    static void tokenizarLinea(std::string_view linea, std::string& buffer, FUrl alUrl, FTermino alTermino) {
+        recorrerTokens(linea, [&](std::string_view token) {
+            if (esSegmentoUrl(token)) {
+                alUrl(token);
+                return;
+            }
+            buffer.assign(token.data(), token.size());
+            for (char& c : buffer) c = aMinuscula(c);
+            alTermino(static_cast<const std::string&>(buffer));
+        });
+    }
+};
+
+#endif // TOKENIZADOR_H
@@ -0,0 +1,292 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Busqueda.h"
+#include "Grafo.h"
+#include "Indexador.h"
+#include "LRUCache.h"
+#include "Stopwords.h"
+#include "Tokenizador.h"
+
+// Suite de benchmarks del motor: tokenizador, construccion del indice, latencia de
+// busqueda por cantidad de terminos, get/put del LRUCache con varias capacidades,
+// insercion de aristas en el grafo y PageRank por iteracion. Cada medicion descarta
+// unas corridas de calentamiento y resume las siguientes con mediana, p99 y minimo;
+// el resultado sale en JSON para comparar una compilacion con otra.
+// Opciones: --corpus <archivo> --stopwords <archivo> --log <archivo> --modo <and|or>
+//           --repeticiones <n> --calentamiento <n> --salida <archivo.json>
+
+struct OpcionesBench {
+    int repeticiones = 10;
+    int calentamiento = 2;
+};
+
+// Resumen de una medicion: tiempos por muestra en ns y trabajo hecho en cada muestra
+struct Medicion {
+    std::string nombre;
+    std::string unidad;       // que cuenta 'operaciones' (bytes, consultas, aristas...)
+    double operaciones = 1.0; // por muestra
+    size_t muestras = 0;
+    double mediana = 0.0;
+    double p99 = 0.0;
+    double minimo = 0.0;
+
+    double porSegundo() const {
+        return mediana > 0 ? operaciones / (mediana / 1e9) : 0.0;
+    }
+};
+
+// Evita que el compilador descarte el trabajo medido
+static volatile uint64_t sumidero = 0;
+
+static double nanosegundosDesde(std::chrono::steady_clock::time_point inicio) {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - inicio).count();
+}
+
+// Mediana, p99 (por rango mas cercano) y minimo de las muestras
+static Medicion resumir(const std::string& nombre, const std::string& unidad, double operaciones, std::vector<double> muestras) {
+    Medicion m;
+    m.nombre = nombre;
+    m.unidad = unidad;
+    m.operaciones = operaciones;
+    m.muestras = muestras.size();
+    if (muestras.empty()) return m;
+    std::sort(muestras.begin(), muestras.end());
+    size_t n = muestras.size();
+    m.mediana = n % 2 == 1 ? muestras[n / 2] : (muestras[n / 2 - 1] + muestras[n / 2]) / 2;
+    m.p99 = muestras[std::min(n - 1, static_cast<size_t>(0.99 * n))];
+    m.minimo = muestras[0];
+    return m;
+}
+
+// Corre preparar() sin medir y correr() midiendo, calentamiento + repeticiones veces
+template <typename Preparar, typename Correr>
+static Medicion medir(const OpcionesBench& opciones, const std::string& nombre, const std::string& unidad, double operaciones, Preparar preparar, Correr correr) {
+    std::vector<double> muestras;
+    for (int r = 0; r < opciones.calentamiento + opciones.repeticiones; r++) {
+        preparar();
+        auto inicio = std::chrono::steady_clock::now();
+        correr();
+        double ns = nanosegundosDesde(inicio);
+        if (r >= opciones.calentamiento) muestras.push_back(ns);
+    }
+    Medicion m = resumir(nombre, unidad, operaciones, muestras);
+    std::cerr << "  " << std::left << std::setw(28) << nombre << std::right << std::fixed << std::setprecision(3)
+              << std::setw(12) << m.mediana / 1e6 << " ms (mediana)\n";
+    return m;
+}
+
+template <typename Correr>
+static Medicion medir(const OpcionesBench& opciones, const std::string& nombre, const std::string& unidad, double operaciones, Correr correr) {
+    return medir(opciones, nombre, unidad, operaciones, []() {}, correr);
+}
+
+static std::string escaparJSON(const std::string& texto) {
+    std::string salida;
+    for (char c : texto) {
+        if (c == '"' || c == '\\') salida += '\\';
+        salida += c;
+    }
+    return salida;
+}
+
+static void escribirJSON(std::ostream& out, const OpcionesBench& opciones, const std::string& corpus, const std::vector<Medicion>& mediciones) {
+    out << std::setprecision(6) << std::fixed;
+    out << "{\n";
+    out << "  \"corpus\": \"" << escaparJSON(corpus) << "\",\n";
+    out << "  \"compilador\": \"" << escaparJSON(__VERSION__) << "\",\n";
+    out << "  \"repeticiones\": " << opciones.repeticiones << ",\n";
+    out << "  \"calentamiento\": " << opciones.calentamiento << ",\n";
+    out << "  \"resultados\": [\n";
+    for (size_t i = 0; i < mediciones.size(); i++) {
+        const Medicion& m = mediciones[i];
+        out << "    {\"nombre\": \"" << escaparJSON(m.nombre) << "\", \"unidad\": \"" << m.unidad << "\""
+            << ", \"operaciones\": " << m.operaciones << ", \"muestras\": " << m.muestras
+            << ", \"mediana_ns\": " << m.mediana << ", \"p99_ns\": " << m.p99 << ", \"min_ns\": " << m.minimo
+            << ", \"ns_por_operacion\": " << (m.operaciones > 0 ? m.mediana / m.operaciones : 0.0)
+            << ", \"por_segundo\": " << m.porSegundo() << "}" << (i + 1 < mediciones.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+int main(int argc, char* argv[]) {
+    std::string corpus = "gov1_pages.dat";
+    std::string stopwordsFile = "stopwords_english.dat.txt";
+    std::string logQueries = "Log-Queries.dat";
+    std::string rutaSalida;
+    ModoConsulta modo = ModoConsulta::OR;
+    OpcionesBench opciones;
+    for (int i = 1; i < argc; i++) {
+        std::string opcion = argv[i];
+        if (opcion == "--corpus" && i + 1 < argc) {
+            corpus = argv[++i];
+        } else if (opcion == "--stopwords" && i + 1 < argc) {
+            stopwordsFile = argv[++i];
+        } else if (opcion == "--log" && i + 1 < argc) {
+            logQueries = argv[++i];
+        } else if (opcion == "--modo" && i + 1 < argc) {
+            if (!leerModo(argv[++i], modo)) std::cerr << "⚠️ Modo desconocido: " << argv[i] << " (se usa or)\n";
+        } else if (opcion == "--repeticiones" && i + 1 < argc) {
+            opciones.repeticiones = std::max(1, std::atoi(argv[++i]));
+        } else if (opcion == "--calentamiento" && i + 1 < argc) {
+            opciones.calentamiento = std::max(0, std::atoi(argv[++i]));
+        } else if (opcion == "--salida" && i + 1 < argc) {
+            rutaSalida = argv[++i];
+        } else {
+            std::cerr << "⚠️ Opcion desconocida: " << opcion << "\n";
+        }
+    }
+
+    ArchivoMapeado archivo;
+    if (!archivo.abrir(corpus)) {
+        std::cerr << "❌ Error al abrir el archivo de documentos" << std::endl;
+        return 1;
+    }
+    std::ifstream queries(logQueries);
+    if (!queries.is_open()) {
+        std::cerr << "❌ No se pudo abrir " << logQueries << "\n";
+        return 1;
+    }
+    std::vector<std::string> consultas;
+    std::string linea;
+    while (std::getline(queries, linea)) consultas.push_back(linea);
+
+    std::vector<Medicion> mediciones;
+    std::cerr << "Benchmarks sobre " << corpus << " (" << opciones.calentamiento << " de calentamiento, "
+              << opciones.repeticiones << " repeticiones)\n";
+
+    // Tokenizador: todo el corpus, sin indexar
+    std::string_view texto = archivo.vista();
+    mediciones.push_back(medir(opciones, "tokenizador", "bytes", static_cast<double>(texto.size()), [&]() {
+        std::string buffer;
+        uint64_t tokens = 0;
+        Tokenizador::recorrerLineas(texto, [&](std::string_view l) {
+            Tokenizador::tokenizarLinea(l, buffer, [&](std::string_view) { tokens++; }, [&](const std::string&) { tokens++; });
+        });
+        sumidero = sumidero + tokens;
+    }));
+
+    // Construccion del indice en un hilo, con la carga de stopwords y el mapeo del archivo
+    Indice indice;
+    mediciones.push_back(medir(opciones, "indiceInvertido", "bytes", static_cast<double>(texto.size()),
+        [&]() { indice = Indice(); },
+        [&]() { indiceInvertido(indice, stopwordsFile, corpus, 1); }));
+    Stopwords sw(indice.stopwords);
+    BM25 bm25;
+
+    // Latencia de busqueda por consulta, agrupando las del log por cantidad de terminos
+    // validos; cada consulta es una muestra
+    struct Clase { std::string nombre; size_t minimo, maximo; };
+    const Clase clases[] = {{"busqueda/1_termino", 1, 1}, {"busqueda/2_terminos", 2, 2}, {"busqueda/5+_terminos", 5, SIZE_MAX}};
+    std::vector<ConsultaNormalizada> normalizadas;
+    for (const auto& consulta : consultas) normalizadas.push_back(normalizarConsulta(consulta, modo, sw));
+    for (const Clase& clase : clases) {
+        std::vector<const ConsultaNormalizada*> elegidas;
+        for (const auto& n : normalizadas) {
+            if (n.terminos.size() >= clase.minimo && n.terminos.size() <= clase.maximo) elegidas.push_back(&n);
+        }
+        std::vector<double> muestras;
+        for (int r = 0; r < opciones.calentamiento + opciones.repeticiones; r++) {
+            for (const ConsultaNormalizada* n : elegidas) {
+                auto inicio = std::chrono::steady_clock::now();
+                ResultadoConsulta resultado = busqueda(indice, bm25, modo, *n);
+                double ns = nanosegundosDesde(inicio);
+                sumidero = sumidero + resultado.docs.size();
+                if (r >= opciones.calentamiento) muestras.push_back(ns);
+            }
+        }
+        Medicion m = resumir(clase.nombre + "/" + nombreModo(modo), "consultas", 1.0, muestras);
+        std::cerr << "  " << std::left << std::setw(28) << m.nombre << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(12) << m.mediana / 1e3 << " us por consulta (mediana, " << elegidas.size() << " consultas)\n";
+        mediciones.push_back(m);
+    }
+
+    // Resultados reales de las consultas del log: valores del cache y cliques del grafo
+    std::vector<ResultadoConsulta> resultados;
+    std::vector<uint64_t> claves;
+    for (const auto& n : normalizadas) {
+        if (n.terminos.empty()) continue;
+        resultados.push_back(busqueda(indice, bm25, modo, n));
+        claves.push_back(n.clave);
+    }
+
+    // LRUCache: puts sobre un cache vacio y gets sobre el cache ya cargado, en el orden del log
+    for (size_t capacidad : {size_t(16) << 10, size_t(256) << 10, size_t(4) << 20}) {
+        std::string sufijo = "/" + std::to_string(capacidad >> 10) + "K";
+        LRUCache<ResultadoConsulta, uint64_t> cache(capacidad);
+        mediciones.push_back(medir(opciones, "lru_put" + sufijo, "operaciones", static_cast<double>(claves.size()),
+            [&]() { cache.clear(); },
+            [&]() {
+                for (size_t i = 0; i < claves.size(); i++) cache.put(claves[i], resultados[i]);
+            }));
+        ResultadoConsulta valor;
+        mediciones.push_back(medir(opciones, "lru_get" + sufijo, "operaciones", static_cast<double>(claves.size()), [&]() {
+            uint64_t aciertos = 0;
+            for (uint64_t clave : claves) aciertos += cache.get(clave, valor);
+            sumidero = sumidero + aciertos;
+        }));
+    }
+
+    // Grafo: la clique de los resultados de cada consulta, con nodos creados de antemano
+    std::vector<std::string_view> urls;
+    std::vector<uint32_t> nodoDeDoc(indice.numDocumentos(), Grafo::SIN_NODO);
+    std::vector<uint64_t> aristas;
+    for (const auto& resultado : resultados) {
+        std::vector<uint32_t> nodos;
+        for (const auto& doc : resultado.docs) {
+            uint32_t& nodo = nodoDeDoc[doc.docID];
+            if (nodo == Grafo::SIN_NODO) {
+                nodo = static_cast<uint32_t>(urls.size());
+                urls.push_back(indice.url(doc.docID));
+            }
+            nodos.push_back(nodo);
+        }
+        for (size_t i = 0; i < nodos.size(); i++) {
+            for (size_t j = i + 1; j < nodos.size(); j++) aristas.push_back((static_cast<uint64_t>(nodos[i]) << 32) | nodos[j]);
+        }
+    }
+    Grafo grafo;
+    auto nodosNuevos = [&]() {
+        grafo = Grafo();
+        for (std::string_view url : urls) grafo.nodo(url);
+    };
+    mediciones.push_back(medir(opciones, "grafo/agregarArista", "aristas", static_cast<double>(aristas.size()), nodosNuevos, [&]() {
+        for (uint64_t arista : aristas) grafo.agregarAristaNoDirigida(static_cast<uint32_t>(arista >> 32), static_cast<uint32_t>(arista));
+        grafo.finalizar();
+    }));
+    mediciones.push_back(medir(opciones, "grafo/agregarLote", "aristas", static_cast<double>(aristas.size()), nodosNuevos, [&]() {
+        grafo.agregarLote(aristas);
+    }));
+
+    // PageRank: un numero fijo de iteraciones (tolerancia 0) con cada metodo, en un hilo
+    const int iteraciones = 20;
+    for (MetodoPageRank metodo : {MetodoPageRank::PULL, MetodoPageRank::GAUSS_SEIDEL, MetodoPageRank::PUSH}) {
+        OpcionesPageRank opcionesPR;
+        opcionesPR.maxIteraciones = iteraciones;
+        opcionesPR.tolerancia = 0.0;
+        opcionesPR.metodo = metodo;
+        mediciones.push_back(medir(opciones, std::string("pagerank/") + nombreMetodo(metodo), "iteraciones", iteraciones, [&]() {
+            ResultadoPageRank pr = grafo.calcularPageRank(opcionesPR);
+            sumidero = sumidero + static_cast<uint64_t>(pr.iteraciones);
+        }));
+    }
+
+    if (rutaSalida.empty()) {
+        escribirJSON(std::cout, opciones, corpus, mediciones);
+    } else {
+        std::ofstream out(rutaSalida);
+        if (!out.is_open()) {
+            std::cerr << "❌ No se pudo crear " << rutaSalida << "\n";
+            return 1;
+        }
+        escribirJSON(out, opciones, corpus, mediciones);
+        std::cerr << "Resultados en " << rutaSalida << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,85 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+#include "Stopwords.h"
+#include "Tokenizador.h"
+
+// Microbenchmark del filtro de stopwords: compara el recorrido lineal que se usaba antes
+// (arreglo de strings comparado uno por uno), un std::unordered_set y el hash perfecto de
+// Stopwords sobre los terminos reales del corpus, en el orden en que los ve el indexador.
+// Opciones: --corpus <archivo> --stopwords <archivo> --repeticiones <n>
+
+static bool busquedaLineal(const std::string& palabra, const std::vector<std::string>& sw) {
+    for (const auto& s : sw) {
+        if (palabra == s) return true;
+    }
+    return false;
+}
+
+// Recorre todos los terminos con el filtro dado; devuelve cuantos son stopwords
+template <typename Filtro>
+static size_t medir(const char* nombre, const std::vector<std::string>& terminos, int repeticiones, Filtro esStopword) {
+    size_t encontradas = 0;
+    auto inicio = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeticiones; r++) {
+        for (const auto& termino : terminos) encontradas += esStopword(termino);
+    }
+    std::chrono::duration<double, std::nano> duracion = std::chrono::steady_clock::now() - inicio;
+    double busquedas = static_cast<double>(terminos.size()) * repeticiones;
+    std::cout << std::left << std::setw(16) << nombre << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << duracion.count() / busquedas << " ns/busqueda"
+              << std::setw(12) << std::setprecision(1) << busquedas / duracion.count() * 1000.0 << " M/s\n";
+    return encontradas / repeticiones;
+}
+
+int main(int argc, char* argv[]) {
+    std::string corpus = "gov1_pages.dat";
+    std::string stopwordsFile = "stopwords_english.dat.txt";
+    int repeticiones = 20;
+    for (int i = 1; i < argc; i++) {
+        std::string opcion = argv[i];
+        if (opcion == "--corpus" && i + 1 < argc) {
+            corpus = argv[++i];
+        } else if (opcion == "--stopwords" && i + 1 < argc) {
+            stopwordsFile = argv[++i];
+        } else if (opcion == "--repeticiones" && i + 1 < argc) {
+            repeticiones = std::max(1, std::atoi(argv[++i]));
+        } else {
+            std::cerr << "⚠️ Opcion desconocida: " << opcion << "\n";
+        }
+    }
+
+    Stopwords perfecto;
+    if (!perfecto.cargar(stopwordsFile)) return 1;
+    const std::vector<std::string>& lista = perfecto.lista();
+    std::unordered_set<std::string> conjunto(lista.begin(), lista.end());
+
+    ArchivoMapeado archivo;
+    if (!archivo.abrir(corpus)) {
+        std::cerr << "❌ Error al abrir el archivo de documentos" << std::endl;
+        return 1;
+    }
+    std::vector<std::string> terminos;
+    std::string buffer;
+    Tokenizador::recorrerLineas(archivo.vista(), [&](std::string_view linea) {
+        Tokenizador::tokenizarLinea(linea, buffer, [](std::string_view) {},
+            [&](const std::string& termino) { terminos.push_back(termino); });
+    });
+    std::cout << "Stopwords: " << lista.size() << ", terminos del corpus: " << terminos.size()
+              << ", repeticiones: " << repeticiones << "\n\n";
+
+    size_t lineal = medir("lineal", terminos, repeticiones, [&](const std::string& t) { return busquedaLineal(t, lista); });
+    size_t hash = medir("unordered_set", terminos, repeticiones, [&](const std::string& t) { return conjunto.count(t) > 0; });
+    size_t perfectas = medir("hash perfecto", terminos, repeticiones, [&](const std::string& t) { return perfecto.contiene(t); });
+
+    if (lineal != hash || lineal != perfectas) {
+        std::cerr << "❌ Los filtros no coinciden: " << lineal << " / " << hash << " / " << perfectas << "\n";
+        return 1;
+    }
+    std::cout << "\nStopwords encontradas: " << perfectas << " de " << terminos.size() << " terminos\n";
+    return 0;
+}
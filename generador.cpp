@@ -0,0 +1,303 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Stopwords.h"
+
+// Generador de datos sinteticos para pruebas de escala: un corpus con el formato de
+// gov1_pages.dat ("http|| host|| ... texto", un documento por linea) y un log de consultas
+// como Log-Queries.dat (una consulta por linea). Los terminos siguen una distribucion de
+// Zipf sobre un vocabulario de palabras inventadas y las consultas repiten, con la tasa
+// dada, consultas anteriores elegidas tambien con Zipf (las primeras en aparecer son las
+// mas populares). Todo sale de la semilla: con los mismos parametros los archivos son
+// identicos byte a byte.
+// Opciones: --docs <n> --consultas <n> --vocabulario <n> --zipf <s> --zipf-consultas <s>
+//           --largo <n> --terminos-consulta <n> --repeticion <p> --proporcion-stopwords <p>
+//           --sitios <n> --semilla <n> --stopwords <archivo> --corpus <archivo> --log <archivo>
+
+struct OpcionesGenerador {
+    uint64_t docs = 10000;
+    uint64_t consultas = 100000;
+    uint64_t vocabulario = 50000;
+    double zipf = 1.0;                // exponente de la frecuencia de los terminos
+    double zipfConsultas = 1.0;       // exponente de la popularidad de las consultas repetidas
+    uint64_t largo = 100;             // terminos por documento en promedio (entre la mitad y 1.5 veces)
+    uint64_t terminosConsulta = 5;    // maximo de terminos por consulta
+    double repeticion = 0.5;          // probabilidad de que una consulta repita una anterior
+    double proporcionStopwords = 0.3; // proporcion de stopwords en el texto
+    uint64_t sitios = 0;              // hosts distintos (0: uno cada 20 documentos)
+    uint64_t semilla = 42;
+};
+
+// splitmix64: secuencia definida por la semilla, sin depender de la biblioteca estandar
+struct Aleatorio {
+    uint64_t estado;
+
+    explicit Aleatorio(uint64_t semilla) : estado(semilla) {}
+
+    uint64_t siguiente() {
+        uint64_t z = (estado += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // En [0, 1)
+    double uniforme() {
+        return static_cast<double>(siguiente() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    // En [0, n)
+    uint64_t entero(uint64_t n) {
+        return n == 0 ? 0 : siguiente() % n;
+    }
+};
+
+// Muestreo de Zipf por rechazo-inversion (Hormann y Derflinger): P(k) proporcional a
+// 1 / k^s para k en [1, n], en O(1) y sin tablas, asi n puede crecer entre muestras.
+class Zipf {
+private:
+    double s;
+    double hIntegralX1;
+    double sParam;
+
+    // log1p(x) / x y expm1(x) / x, estables cerca de 0
+    static double auxiliar1(double x) {
+        return std::fabs(x) > 1e-8 ? std::log1p(x) / x : 1.0 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x));
+    }
+
+    static double auxiliar2(double x) {
+        return std::fabs(x) > 1e-8 ? std::expm1(x) / x : 1.0 + x * 0.5 * (1.0 + x / 3.0 * (1.0 + 0.25 * x));
+    }
+
+    double h(double x) const {
+        return std::exp(-s * std::log(x));
+    }
+
+    double hIntegral(double x) const {
+        double logX = std::log(x);
+        return auxiliar2((1.0 - s) * logX) * logX;
+    }
+
+    double hIntegralInversa(double x) const {
+        double t = std::max(-1.0, x * (1.0 - s));
+        return std::exp(auxiliar1(t) * x);
+    }
+
+public:
+    explicit Zipf(double _s) : s(_s) {
+        hIntegralX1 = hIntegral(1.5) - 1.0;
+        sParam = 2.0 - hIntegralInversa(hIntegral(2.5) - h(2.0));
+    }
+
+    // Rango en [0, n), el 0 es el mas probable
+    uint64_t muestra(uint64_t n, Aleatorio& rng) const {
+        if (n <= 1) return 0;
+        if (s <= 0) return rng.entero(n);
+        double hIntegralN = hIntegral(static_cast<double>(n) + 0.5);
+        while (true) {
+            double u = hIntegralN + rng.uniforme() * (hIntegralX1 - hIntegralN);
+            double x = hIntegralInversa(u);
+            double k = std::floor(x + 0.5);
+            k = std::min(std::max(k, 1.0), static_cast<double>(n));
+            if (k - x <= sParam || u >= hIntegral(k + 0.5) - h(k)) return static_cast<uint64_t>(k) - 1;
+        }
+    }
+};
+
+// Vocabulario de palabras pronunciables: la palabra i es i escrito en base biyectiva de
+// silabas consonante-vocal (al menos dos silabas). Se saltean las que son stopwords, para
+// que cada palabra del vocabulario llegue al indice.
+static std::vector<std::string> armarVocabulario(uint64_t tamano, const Stopwords& sw) {
+    static const char consonantes[] = "bcdfghjklmnprstvwxyz";
+    static const char vocales[] = "aeiou";
+    const uint64_t silabas = 20 * 5;
+    std::vector<std::string> palabras;
+    palabras.reserve(tamano);
+    for (uint64_t i = silabas; palabras.size() < tamano; i++) {
+        std::string palabra;
+        for (uint64_t resto = i + 1; resto > 0; resto = (resto - 1) / silabas) {
+            uint64_t silaba = (resto - 1) % silabas;
+            palabra += consonantes[silaba / 5];
+            palabra += vocales[silaba % 5];
+        }
+        if (!sw.contiene(palabra)) palabras.push_back(palabra);
+    }
+    return palabras;
+}
+
+// Escritura con un buffer propio de 1 MB
+class Salida {
+private:
+    std::ofstream out;
+    std::string buffer;
+
+public:
+    uint64_t bytes = 0;
+
+    bool abrir(const std::string& ruta) {
+        out.open(ruta, std::ios::binary | std::ios::trunc);
+        buffer.reserve(size_t(1) << 20);
+        return out.is_open();
+    }
+
+    void agregar(const std::string& texto) {
+        buffer += texto;
+        if (buffer.size() >= (size_t(1) << 20)) vaciar();
+    }
+
+    void vaciar() {
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        bytes += buffer.size();
+        buffer.clear();
+    }
+
+    bool cerrar() {
+        vaciar();
+        out.close();
+        return !out.fail();
+    }
+};
+
+// Semilla propia de cada documento o consulta: se pueden generar en cualquier orden
+static uint64_t semillaDe(uint64_t semilla, uint64_t flujo, uint64_t i) {
+    Aleatorio mezcla(semilla ^ (flujo * 0xD1B54A32D192ED03ull) ^ (i * 0x9E3779B97F4A7C15ull));
+    return mezcla.siguiente();
+}
+
+int main(int argc, char* argv[]) {
+    OpcionesGenerador opciones;
+    std::string stopwordsFile = "stopwords_english.dat.txt";
+    std::string rutaCorpus = "sintetico_pages.dat";
+    std::string rutaLog = "sintetico_queries.dat";
+    for (int i = 1; i < argc; i++) {
+        std::string opcion = argv[i];
+        if (opcion == "--docs" && i + 1 < argc) {
+            opciones.docs = std::stoull(argv[++i]);
+        } else if (opcion == "--consultas" && i + 1 < argc) {
+            opciones.consultas = std::stoull(argv[++i]);
+        } else if (opcion == "--vocabulario" && i + 1 < argc) {
+            opciones.vocabulario = std::max<uint64_t>(1, std::stoull(argv[++i]));
+        } else if (opcion == "--zipf" && i + 1 < argc) {
+            opciones.zipf = std::max(0.0, std::stod(argv[++i]));
+        } else if (opcion == "--zipf-consultas" && i + 1 < argc) {
+            opciones.zipfConsultas = std::max(0.0, std::stod(argv[++i]));
+        } else if (opcion == "--largo" && i + 1 < argc) {
+            opciones.largo = std::max<uint64_t>(1, std::stoull(argv[++i]));
+        } else if (opcion == "--terminos-consulta" && i + 1 < argc) {
+            opciones.terminosConsulta = std::max<uint64_t>(1, std::stoull(argv[++i]));
+        } else if (opcion == "--repeticion" && i + 1 < argc) {
+            opciones.repeticion = std::min(1.0, std::max(0.0, std::stod(argv[++i])));
+        } else if (opcion == "--proporcion-stopwords" && i + 1 < argc) {
+            opciones.proporcionStopwords = std::min(1.0, std::max(0.0, std::stod(argv[++i])));
+        } else if (opcion == "--sitios" && i + 1 < argc) {
+            opciones.sitios = std::stoull(argv[++i]);
+        } else if (opcion == "--semilla" && i + 1 < argc) {
+            opciones.semilla = std::stoull(argv[++i]);
+        } else if (opcion == "--stopwords" && i + 1 < argc) {
+            stopwordsFile = argv[++i];
+        } else if (opcion == "--corpus" && i + 1 < argc) {
+            rutaCorpus = argv[++i];
+        } else if (opcion == "--log" && i + 1 < argc) {
+            rutaLog = argv[++i];
+        } else {
+            std::cerr << "⚠️ Opcion desconocida: " << opcion << "\n";
+        }
+    }
+    if (opciones.sitios == 0) opciones.sitios = std::max<uint64_t>(1, opciones.docs / 20);
+
+    Stopwords sw;
+    if (!sw.cargar(stopwordsFile)) return 1;
+    const std::vector<std::string>& stopwords = sw.lista();
+    if (stopwords.empty()) opciones.proporcionStopwords = 0.0;
+    std::vector<std::string> vocabulario = armarVocabulario(opciones.vocabulario, sw);
+    Zipf zipfTerminos(opciones.zipf);
+    Zipf zipfConsultas(opciones.zipfConsultas);
+    Zipf zipfLargoConsulta(1.0);
+
+    auto inicio = std::chrono::steady_clock::now();
+    auto agregarTermino = [&](std::string& linea, Aleatorio& rng) {
+        if (opciones.proporcionStopwords > 0 && rng.uniforme() < opciones.proporcionStopwords) {
+            linea += stopwords[rng.entero(stopwords.size())];
+        } else {
+            linea += vocabulario[zipfTerminos.muestra(vocabulario.size(), rng)];
+        }
+    };
+
+    // Corpus: URL unica por documento (host y dominio del sitio, elegido con Zipf, y pagina)
+    // y texto de largo variable
+    Salida corpus;
+    if (!corpus.abrir(rutaCorpus)) {
+        std::cerr << "❌ No se pudo crear " << rutaCorpus << "\n";
+        return 1;
+    }
+    std::string linea;
+    for (uint64_t d = 0; d < opciones.docs; d++) {
+        Aleatorio rng(semillaDe(opciones.semilla, 1, d));
+        uint64_t sitio = zipfTerminos.muestra(opciones.sitios, rng);
+        Aleatorio rngSitio(semillaDe(opciones.semilla, 2, sitio));
+        linea = "http|| ";
+        linea += vocabulario[rngSitio.entero(vocabulario.size())];
+        linea += "|| ";
+        linea += vocabulario[rngSitio.entero(vocabulario.size())];
+        linea += "|| gov|| p";
+        linea += std::to_string(d);
+        linea += "||";
+        uint64_t largo = opciones.largo / 2 + rng.entero(opciones.largo + 1);
+        for (uint64_t t = 0; t < std::max<uint64_t>(1, largo); t++) {
+            linea += ' ';
+            agregarTermino(linea, rng);
+        }
+        linea += '\n';
+        corpus.agregar(linea);
+    }
+    if (!corpus.cerrar()) {
+        std::cerr << "❌ Error al escribir " << rutaCorpus << "\n";
+        return 1;
+    }
+
+    // Log: cada consulta es nueva o repite una de las nuevas anteriores; la consulta nueva
+    // numero q sale siempre de la misma semilla, asi repetirla es volver a generarla
+    Salida log;
+    if (!log.abrir(rutaLog)) {
+        std::cerr << "❌ No se pudo crear " << rutaLog << "\n";
+        return 1;
+    }
+    Aleatorio rngLog(semillaDe(opciones.semilla, 3, 0));
+    uint64_t nuevas = 0;
+    for (uint64_t c = 0; c < opciones.consultas; c++) {
+        uint64_t q;
+        if (nuevas > 0 && rngLog.uniforme() < opciones.repeticion) {
+            q = zipfConsultas.muestra(nuevas, rngLog);
+        } else {
+            q = nuevas++;
+        }
+        // Cantidad de terminos con probabilidad proporcional a 1 / n
+        Aleatorio rng(semillaDe(opciones.semilla, 4, q));
+        uint64_t terminos = zipfLargoConsulta.muestra(opciones.terminosConsulta, rng) + 1;
+        linea.clear();
+        for (uint64_t t = 0; t < terminos; t++) {
+            if (t > 0) linea += ' ';
+            agregarTermino(linea, rng);
+        }
+        linea += '\n';
+        log.agregar(linea);
+    }
+    if (!log.cerrar()) {
+        std::cerr << "❌ Error al escribir " << rutaLog << "\n";
+        return 1;
+    }
+
+    std::chrono::duration<double> duracion = std::chrono::steady_clock::now() - inicio;
+    std::cout << "✅ " << rutaCorpus << ": " << opciones.docs << " documentos, " << corpus.bytes << " bytes\n";
+    std::cout << "✅ " << rutaLog << ": " << opciones.consultas << " consultas (" << nuevas << " nuevas), "
+              << log.bytes << " bytes\n";
+    std::cout << "  -> Vocabulario: " << vocabulario.size() << " palabras, zipf " << opciones.zipf
+              << ", semilla " << opciones.semilla << "\n";
+    std::cout << "  -> Tiempo: " << duracion.count() << " s\n";
+    return 0;
+}
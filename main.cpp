@@ -1,105 +1,46 @@
 #include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <algorithm>
 #include <chrono>
-#include "Document.h"
+#include "Indice.h"
+#include "ArchivoIndice.h"
+#include "Ranking.h"
+#include "Evaluacion.h"
+#include "Tokenizador.h"
+#include "CacheConcurrente.h"
 #include "LRUCache.h"
+#include "PoolHilos.h"
+#include "Stopwords.h"
 #include <fcntl.h>
 #include <set>
+#include <thread>
+#include <unordered_map>
 #include <filesystem>
 #include <vector>
 #include "Grafo.h"
+#include "PageRankIncremental.h"
+#include "RankingEstatico.h"
+#include "Indexador.h"
+#include "Busqueda.h"
+#include "ArchivoGrafo.h"
+#include "Metricas.h"
 #ifdef _WIN32
 #include <windows.h>
 #include <io.h>
 #endif
 
-// Cargar stopwords en un arreglo (esto puede usarse para cualquier archivo de stopwords)
-void cargarStopwords(const std::string& stopwordsFile, std::string sw[], int& count) {
-    std::ifstream stop_words(stopwordsFile);
-    if (!stop_words.is_open()) {
-        std::cerr << "❌ Error al abrir el archivo de stopwords" << std::endl;
-        return;
-    }
-    std::string line;
-    count = 0;
-    while (std::getline(stop_words, line) && count < 100) {
-        sw[count++] = line;
-    }
-
-    stop_words.close();
-}
-
-// Verifica si una palabra es una stopword
-bool esStopword(const std::string& palabra, const std::string sw[], int count) {
-    for (int i = 0; i < count; i++) {
-        if (palabra == sw[i]) return true;
-    }
-    return false;
-}
-
-// Procesa una palabra y actualiza el indice invertido
-void procesarPalabra(const std::string& palabra, const std::string& url, std::map<std::string, Document*>& map, const std::string sw[], int swCount) {
-    std::string word = palabra;
-    std::transform(word.begin(), word.end(), word.begin(), [](unsigned char c){ return std::tolower(c); });
-
-    if (esStopword(word, sw, swCount)) return;
-
-    if (map.find(word) == map.end()) {
-        map[word] = new Document(url);
-    } else {
-        Document* actual = map[word];
-        while (actual != nullptr) {
-            if (actual->url == url) return; // Ya existe
-            actual = actual->next;
-        }
-
-        // Insertar al final de la lista enlazada
-        actual = map[word];
-        while (actual->next != nullptr) actual = actual->next;
-        actual->next = new Document(url);
-    }
-}
-
-// Procesar archivo de documentos y construye el indice invertido
-void indiceInvertido(std::map<std::string, Document*>& map, const std::string& stopwordsFile, const std::string& documentosFile) {
-    std::string sw[100]; //La cantidad de palabras que son stopword
-    int swCount = 0; //contador
-    cargarStopwords(stopwordsFile, sw, swCount); //llamamos a la funcion cargarStopwords
-
-    std::ifstream doc(documentosFile);
-    if (!doc.is_open()) {
-        std::cerr << "❌ Error al abrir el archivo de documentos" << std::endl;
-        return;
-    }
-
-    std::string lineas;
-    while (std::getline(doc, lineas)) {
-        std::string url, word;
-        std::istringstream stream(lineas);
-
-        while (stream >> word) {
-            if (word.size() >= 2 && word.substr(word.size() - 2) == "||") {
-                url += word;
-            } else {
-                procesarPalabra(word, url, map, sw, swCount);
-            }
-        }
-    }
-    doc.close();
-}
-
 // Imprimir indice invertido
-void printIndice(const std::map<std::string, Document*>& indice) {
-    for (const auto& par : indice) {
+void printIndice(const Indice& indice) {
+    for (const auto& par : indice.terminos) {
         std::cout << "Clave: " << par.first << std::endl;
-        Document* nodo = par.second;
-        while (nodo != nullptr) {
-            std::cout << "    URL: " << nodo->url << std::endl;
-            nodo = nodo->next;
+        for (CursorPostings cursor = indice.postingsDe(par.second); !cursor.fin(); cursor.siguiente()) {
+            std::cout << "    URL: " << indice.url(cursor.docID()) << std::endl;
         }
         std::cout << std::endl;
     }
@@ -107,113 +48,86 @@ void printIndice(const std::map<std::string, Document*>& indice) {
 
 
  // Funcion auxiliar para obtener todas las URLs asociadas a una palabra
- std::set<std::string> obtenerURLs(Document* nodo) {
+ std::set<std::string> obtenerURLs(const Indice& indice, CursorPostings cursor) {
      std::set<std::string> urls;
-     while (nodo != nullptr) {
-         urls.insert(nodo->url);
-         nodo = nodo->next;
+     for (; !cursor.fin(); cursor.siguiente()) {
+         urls.insert(std::string(indice.url(cursor.docID())));
      }
      return urls;
  }
 
-// Funcion de busqueda con interseccion de documentos
-std::string busqueda(std::map<std::string, Document*>& map, const std::string sw[100], int swCount, const std::string& texto) {
-    std::stringstream ss(texto);
-    listaString* palabras = nullptr; // Lista enlazada
-
-    // Crear lista enlazada con las palabras ingresadas por el usuario
-    std::string palabra;
-    while (ss >> palabra) {
-        std::transform(palabra.begin(), palabra.end(), palabra.begin(), [](unsigned char c) {
-            return std::tolower(c);
-        });
-
-        if (esStopword(palabra, sw, swCount)) continue;
-
-        listaString* nuevoNodo = new listaString(palabra);
-        if (palabras == nullptr) {
-            palabras = nuevoNodo;
-        } else {
-            listaString* aux = palabras;
-            while (aux->next != nullptr) aux = aux->next;
-            aux->next = nuevoNodo;
-        }
-    }
-
-    // Validacion de que al menos exista una palabra valida
-    if (!palabras) {
+// Texto de un resultado, tal como se escribe en ResultQueries.txt y se muestra en la interfaz
+std::string formatearResultado(const Indice& indice, const ResultadoConsulta& resultado) {
+    CronometroEtapa medir(Etapa::FORMATO);
+    if (resultado.sinPalabras) {
         return "⚠️ No se ingresaron palabras validas.\n";
     }
-
-    // Sumar frecuencias de todas las URLs relacionadas con las palabras de la consulta
-    std::map<std::string, int> frecuenciaURLs;
-    listaString* key = palabras;
-    while (key != nullptr) {
-        auto it = map.find(key->value);
-        if (it != map.end()) {
-            Document* doc = it->second;
-            while (doc != nullptr) {
-                frecuenciaURLs[doc->url] += doc->frecuencia;
-                doc = doc->next;
-            }
-        }
-        key = key->next;
-    }
-
-    // Ordenar por frecuencia descendente
-    std::vector<std::pair<std::string, int>> ordenado(frecuenciaURLs.begin(), frecuenciaURLs.end());
-    std::sort(ordenado.begin(), ordenado.end(), [](const auto& a, const auto& b) {
-        return a.second > b.second;
-    });
-
-    // Construir el string de resultado
     std::ostringstream out;
-    if (ordenado.empty()) {
+    if (resultado.docs.empty()) {
         out << "⚠️ No se encontraron documentos con las palabras ingresadas.\n";
     } else {
         out << "Documentos encontrados:\n";
-        int count = 0;
-        for (const auto& par : ordenado) {
-            if (count >= 10) break; // Solo los 10 mas relevantes
-            out << " - " << par.second << " - " << par.first << "\n";
-            count++;
+        for (const auto& doc : resultado.docs) {
+            out << " - " << doc.puntaje << " - " << indice.url(doc.docID) << "\n";
         }
     }
-
-    // Liberar memoria de la lista enlazada
-    while (palabras != nullptr) {
-        listaString* temp = palabras;
-        palabras = palabras->next;
-        delete temp;
-    }
-
     return out.str();
 }
 
-// Extrae los 10 documentos mas relevantes de una consulta
-std::vector<std::string> obtenerDocsRelevantes(const std::map<std::string, int>& frecuenciaURLs) {
-    std::vector<std::pair<std::string, int>> ordenado(frecuenciaURLs.begin(), frecuenciaURLs.end());
-    std::sort(ordenado.begin(), ordenado.end(), [](const auto& a, const auto& b) {
-        return a.second > b.second;
-    });
+// URLs de los 10 documentos mas relevantes de una consulta
+std::vector<std::string> obtenerDocsRelevantes(const Indice& indice, const std::vector<DocResultado>& topDocs) {
     std::vector<std::string> docs;
-    for (size_t i = 0; i < ordenado.size() && i < 10; ++i) {
-        docs.push_back(ordenado[i].first);
+    for (const auto& doc : topDocs) {
+        docs.push_back(std::string(indice.url(doc.docID)));
     }
     return docs;
 }
 
-// Construye el grafo a partir de los resultados de cada consulta (solo no dirigido)
-void construirGrafo(Grafo& grafo, const std::vector<std::string>& docsRelevantes) {
-    for (size_t i = 0; i < docsRelevantes.size(); ++i) {
-        for (size_t j = i + 1; j < docsRelevantes.size(); ++j) {
-            grafo.agregarAristaNoDirigida(docsRelevantes[i], docsRelevantes[j]);
+// Emite la clique de los resultados de una consulta como claves (u << 32) | v de nodos
+// del grafo, que despues se cargan de una vez con Grafo::agregarLote (solo no dirigido).
+// 'nodoDeDoc' guarda el nodo de cada docID: la URL se busca solo la primera vez.
+void construirGrafo(Grafo& grafo, const Indice& indice, const std::vector<DocResultado>& docs, std::vector<uint32_t>& nodoDeDoc, std::vector<uint64_t>& claves) {
+    if (docs.size() < 2) return;
+    CronometroEtapa medir(Etapa::GRAFO);
+    size_t n = docs.size();
+    std::vector<uint32_t> nodos(n);
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t& nodo = nodoDeDoc[docs[i].docID];
+        if (nodo == Grafo::SIN_NODO) nodo = grafo.nodo(indice.url(docs[i].docID));
+        nodos[i] = nodo;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = i + 1; j < n; ++j) {
+            claves.push_back((static_cast<uint64_t>(nodos[i]) << 32) | nodos[j]);
+        }
+    }
+}
+
+// Agrega al grafo la clique de una consulta interactiva y pone al dia el PageRank
+// incremental; devuelve cuantos empujes de residuo hicieron falta
+uint64_t actualizarGrafo(Grafo& grafo, PageRankIncremental& pagerank, const Indice& indice, const std::vector<DocResultado>& topDocs) {
+    CronometroEtapa medir(Etapa::GRAFO);
+    std::vector<uint32_t> nodos;
+    for (const auto& doc : topDocs) {
+        nodos.push_back(grafo.nodo(indice.url(doc.docID)));
+    }
+    std::vector<std::pair<uint32_t, uint32_t>> pares;
+    for (size_t i = 0; i < nodos.size(); ++i) {
+        for (size_t j = i + 1; j < nodos.size(); ++j) {
+            grafo.agregarAristaNoDirigida(nodos[i], nodos[j]);
+            pares.emplace_back(nodos[i], nodos[j]);
         }
     }
+    grafo.finalizar();
+    return pagerank.aristasAgregadas(pares);
 }
 
 // Interfaz interactiva para consultas
-void interfazConsultas(const Grafo& grafo, const std::map<std::string, double>& pagerank, LRUCache* cache, std::map<std::string, Document*>& map, const std::string sw[], int swCount, int& totalConsultas, int& hits, int& misses, int& inserciones, int& reemplazos) {
+// Con prIncremental (--pr-incremental), cada 'buscar' agrega al grafo la clique de sus resultados
+// (como las consultas del log) y el PageRank se mantiene con empujes de residuo en lugar de
+// recalcularse; sin el, el grafo queda fijo y se usa el PageRank del arranque.
+// Con una fusion, 'buscar' ordena por BM25 y PageRank (cacheado aparte de solo BM25).
+void interfazConsultas(Grafo& grafo, const std::vector<double>& pagerank, PageRankIncremental* prIncremental, CacheConcurrente<ResultadoConsulta, uint64_t>* cache, const Indice& indice, const IndiceEstatico& estatico, const OpcionesFusion& fusion, const BM25& bm25, ModoConsulta& modo, const Stopwords& sw) {
     std::cout << "\n=== INTERFAZ DE CONSULTAS INTERACTIVA ===\n";
     std::cout << "Comandos disponibles:\n";
     std::cout << "1. 'grafo <url>'          - Mostrar conexiones de un nodo en el grafo\n";
@@ -224,9 +138,15 @@ void interfazConsultas(const Grafo& grafo, const std::map<std::string, double>&
     std::cout << "6. 'mostrar-cache'        - Mostrar todo el contenido del cache\n";
     std::cout << "7. 'limpiar-cache'        - Eliminar todo el contenido del cache y reiniciar estadísticas\n";
     std::cout << "8. 'stats'                - Mostrar estadisticas generales\n";
-    std::cout << "9. 'salir'                - Terminar interfaz\n";
+    std::cout << "9. 'modo <and|or>'        - Cambiar la semantica de las consultas (actual: " << nombreModo(modo) << ")\n";
+    std::cout << "10. 'metrics-dump [archivo]' - Guardar contadores y latencias por etapa en JSON (por defecto metricas.json)\n";
+    std::cout << "11. 'salir'               - Terminar interfaz\n";
     std::cout << "=========================================\n";
     
+    // PageRank normalizado de un nodo, al dia con las consultas de la interfaz
+    auto nodosConPR = [&]() { return prIncremental != nullptr ? prIncremental->size() : pagerank.size(); };
+    auto valorPR = [&](uint32_t u) { return prIncremental != nullptr ? prIncremental->valor(u) : pagerank[u]; };
+
     std::string comando;
     while (true) {
         std::cout << "\n> Ingrese comando: ";
@@ -255,15 +175,15 @@ void interfazConsultas(const Grafo& grafo, const std::map<std::string, double>&
             }
             
             // Buscar en el grafo
-            auto it = grafo.adj.find(parametro);
-            if (it != grafo.adj.end()) {
+            uint32_t u = grafo.buscarNodo(parametro);
+            if (u != Grafo::SIN_NODO && u < grafo.numNodos()) {
                 std::cout << "Documento '" << parametro << "' encontrado en el grafo\n";
-                std::cout << "Conexiones (" << it->second.size() << " documentos relacionados):\n";
+                std::cout << "Conexiones (" << grafo.grado(u) << " documentos relacionados):\n";
                 int count = 0;
-                for (const auto& vecino : it->second) {
-                    std::cout << "  " << (++count) << ". " << vecino.first << " (peso: " << vecino.second << ")\n";
+                for (uint64_t e = grafo.desplazamientos[u]; e < grafo.finVecinos(u); e++) {
+                    std::cout << "  " << (++count) << ". " << grafo.url(grafo.vecinos[e]) << " (peso: " << grafo.pesos[e] << ")\n";
                     if (count >= 10) {
-                        std::cout << "  ... y " << (it->second.size() - 10) << " mas\n";
+                        std::cout << "  ... y " << (grafo.grado(u) - 10) << " mas\n";
                         break;
                     }
                 }
@@ -277,16 +197,17 @@ void interfazConsultas(const Grafo& grafo, const std::map<std::string, double>&
                 continue;
             }
             
-            auto it = pagerank.find(parametro);
-            if (it != pagerank.end()) {
-                std::cout << "PageRank de '" << parametro << "': " << it->second << "\n";
+            uint32_t u = grafo.buscarNodo(parametro);
+            if (u != Grafo::SIN_NODO && u < nodosConPR()) {
+                double valor = valorPR(u);
+                std::cout << "PageRank de '" << parametro << "': " << valor << "\n";
                 
                 // Calcular ranking relativo
                 int mejoresQue = 0;
-                for (const auto& pr : pagerank) {
-                    if (pr.second > it->second) mejoresQue++;
+                for (uint32_t v = 0; v < nodosConPR(); v++) {
+                    if (valorPR(v) > valor) mejoresQue++;
                 }
-                std::cout << "Ranking: #" << (mejoresQue + 1) << " de " << pagerank.size() << " documentos\n";
+                std::cout << "Ranking: #" << (mejoresQue + 1) << " de " << nodosConPR() << " documentos\n";
             } else {
                 std::cout << "Documento '" << parametro << "' no tiene PageRank calculado\n";
             }
@@ -297,9 +218,10 @@ void interfazConsultas(const Grafo& grafo, const std::map<std::string, double>&
                 continue;
             }
             
-            if (cache->contains(parametro)) {
+            uint64_t clave = claveConFusion(normalizarConsulta(parametro, modo, sw).clave, fusion);
+            if (cache->contains(clave)) {
                 std::cout << "Consulta '" << parametro << "' esta en cache\n";
-                std::string resultado = cache->get(parametro);
+                std::string resultado = formatearResultado(indice, cache->get(clave));
                 std::cout << "Resultado cacheado:\n";
                 // Mostrar solo las primeras 3 lineas del resultado
                 std::istringstream stream(resultado);
@@ -320,41 +242,56 @@ void interfazConsultas(const Grafo& grafo, const std::map<std::string, double>&
                 continue;
             }
             
-            std::cout << "Buscando: '" << parametro << "'\n";
-            totalConsultas++; // Incrementar total de consultas procesadas
+            std::cout << "Buscando: '" << parametro << "' (modo " << nombreModo(modo) << ", fusion " << nombreFusion(fusion.tipo) << ")\n";
+            RegistroMetricas& metricas = RegistroMetricas::global();
+            metricas.sumar(Contador::CONSULTAS);
+            ConsultaNormalizada normalizada = normalizarConsulta(parametro, modo, sw);
+            uint64_t clave = claveConFusion(normalizada.clave, fusion);
             
             // Verificar si ya esta en cache
-            if (cache->contains(parametro)) {
-                std::string resultadoCache = cache->get(parametro);
+            ResultadoConsulta resultadoCache;
+            CronometroEtapa medirCache(Etapa::CACHE);
+            bool acierto = cache->buscar(clave, resultadoCache);
+            medirCache.detener();
+            if (acierto) {
                 std::cout << "[CACHE HIT] Resultado encontrado en cache:\n";
-                std::cout << resultadoCache;
-                hits++; // Incrementar hits
+                std::cout << formatearResultado(indice, resultadoCache);
+                metricas.sumar(Contador::HITS);
             } else {
                 std::cout << "[CACHE MISS] Calculando resultado...\n";
                 // Realizar busqueda
-                std::string resultado = busqueda(map, sw, swCount, parametro);
+                ResultadoConsulta resultado = busqueda(indice, bm25, modo, normalizada, &estatico, fusion);
                 
-                // Solo cachear si el resultado es valido (no es "No se encontraron documentos...")
-                if (resultado.find("No se encontraron documentos") == std::string::npos && 
-                    resultado.find("No se ingresaron palabras") == std::string::npos) {
-                    
-                    // Verificar si el cache esta lleno para contar reemplazos
-                    if (cache->getSize() >= cache->getMaxSize()) {
-                        reemplazos++; // Se va a eliminar un elemento
-                    }
+                // Solo cachear si el resultado es valido (con documentos encontrados)
+                if (!resultado.docs.empty()) {
                     
-                    // Cachear el resultado valido
-                    cache->put(parametro, resultado);
-                    inserciones++; // Incrementar inserciones
+                    // Cachear el resultado valido (cuenta las entradas desalojadas para hacerle lugar)
+                    metricas.sumar(Contador::REEMPLAZOS, cache->insertar(clave, resultado));
+                    metricas.sumar(Contador::INSERCIONES);
                     std::cout << "Resultado calculado y guardado en cache:\n";
                 } else {
                     std::cout << "Resultado calculado (no cacheado - sin resultados):\n";
                 }
                 
-                misses++; // Incrementar misses
-                std::cout << resultado;
+                metricas.sumar(Contador::MISSES);
+                std::cout << formatearResultado(indice, resultado);
+                resultadoCache = resultado;
+            }
+
+            // Los resultados de la consulta pasan a ser aristas del grafo de co-relevancia
+            if (prIncremental != nullptr && resultadoCache.docs.size() >= 2) {
+                uint64_t empujes = actualizarGrafo(grafo, *prIncremental, indice, resultadoCache.docs);
+                std::cout << "Grafo actualizado: " << grafo.numNodos() << " nodos, " << grafo.numAristas() << " aristas ("
+                          << empujes << " empujes de PageRank, cota de error L1: " << prIncremental->cotaError() << ")\n";
             }
         }
+        else if (accion == "modo") {
+            if (!leerModo(parametro, modo)) {
+                std::cout << "⚠️ Modo invalido. Use: modo and | modo or\n";
+                continue;
+            }
+            std::cout << "Modo de consulta: " << nombreModo(modo) << "\n";
+        }
         else if (accion == "top-pagerank") {
             int n = 10; // Por defecto
             if (!parametro.empty()) {
@@ -366,37 +303,38 @@ void interfazConsultas(const Grafo& grafo, const std::map<std::string, double>&
                 }
             }
             
-            // Ordenar por PageRank
-            std::vector<std::pair<std::string, double>> rankingPR;
-            for (const auto& pr : pagerank) {
-                rankingPR.push_back({pr.first, pr.second});
-            }
-            std::sort(rankingPR.begin(), rankingPR.end(), [](const auto& a, const auto& b) {
-                return a.second > b.second;
+            // Ordenar por PageRank (empates por URL); solo hacen falta los primeros n
+            std::vector<uint32_t> rankingPR(nodosConPR());
+            for (uint32_t u = 0; u < rankingPR.size(); u++) rankingPR[u] = u;
+            n = std::max(0, std::min(n, (int)rankingPR.size()));
+            std::partial_sort(rankingPR.begin(), rankingPR.begin() + n, rankingPR.end(), [&](uint32_t a, uint32_t b) {
+                if (valorPR(a) != valorPR(b)) return valorPR(a) > valorPR(b);
+                return grafo.url(a) < grafo.url(b);
             });
             
             std::cout << "Top " << n << " documentos por PageRank:\n";
-            for (int i = 0; i < std::min(n, (int)rankingPR.size()); i++) {
-                std::cout << "  " << (i+1) << ". " << rankingPR[i].second 
-                         << " - " << rankingPR[i].first << "\n";
+            for (int i = 0; i < n; i++) {
+                std::cout << "  " << (i+1) << ". " << valorPR(rankingPR[i])
+                         << " - " << grafo.url(rankingPR[i]) << "\n";
             }
         }
         else if (accion == "mostrar-cache") {
             std::cout << "📋 Contenido completo del cache LRU:\n";
-            std::cout << "   Estado actual: " << cache->getSize() << "/" << cache->getMaxSize() << " elementos\n\n";
+            std::cout << "   Estado actual: " << cache->getSize() << " elementos, " << cache->getBytes() << "/" << cache->getMaxBytes() << " bytes\n\n";
             
             if (cache->getSize() == 0) {
                 std::cout << "   ⚠️ El cache esta vacio\n";
             } else {
-                // Obtener todas las consultas del cache
-                std::vector<std::string> consultasEnCache = cache->getAllKeys();
+                // Obtener todas las claves (hash de la consulta canonica) del cache
+                std::vector<uint64_t> consultasEnCache = cache->getAllKeys();
                 
                 std::cout << "   === CONSULTAS EN CACHE (ordenadas por uso reciente) ===\n";
                 for (size_t i = 0; i < consultasEnCache.size(); i++) {
-                    std::cout << "   [" << (i+1) << "] Consulta: \"" << consultasEnCache[i] << "\"\n";
+                    std::cout << "   [" << (i+1) << "] Clave: " << std::hex << std::setw(16) << std::setfill('0') << consultasEnCache[i]
+                              << std::dec << std::setfill(' ') << "\n";
                     
                     // Obtener el resultado (esto también actualiza el LRU)
-                    std::string resultado = cache->get(consultasEnCache[i]);
+                    std::string resultado = formatearResultado(indice, cache->get(consultasEnCache[i]));
                     
                     // Mostrar las primeras 2 líneas del resultado
                     std::istringstream stream(resultado);
@@ -416,18 +354,20 @@ void interfazConsultas(const Grafo& grafo, const std::map<std::string, double>&
         }
         else if (accion == "stats") {
             std::cout << "📊 Estadisticas del sistema:\n";
-            std::cout << "  -> Nodos en el grafo: " << grafo.adj.size() << "\n";
-            
-            int totalAristas = 0;
-            for (const auto& par : grafo.adj) {
-                totalAristas += par.second.size();
+            std::cout << "  -> Nodos en el grafo: " << grafo.numNodos() << "\n";
+            std::cout << "  -> Aristas en el grafo: " << grafo.numAristas() << "\n";
+            std::cout << "  -> Documentos con PageRank: " << nodosConPR() << "\n";
+            if (prIncremental != nullptr) {
+                std::cout << "  -> PageRank incremental: " << prIncremental->empujesTotales() << " empujes, " << prIncremental->barridosTotales()
+                          << " barridos, cota de error L1: " << prIncremental->cotaError() << "\n";
             }
-            totalAristas /= 2; // No dirigido
-            std::cout << "  -> Aristas en el grafo: " << totalAristas << "\n";
-            std::cout << "  -> Documentos con PageRank: " << pagerank.size() << "\n";
             
             // Metricas detalladas del cache
-            std::cout << "\n  === METRICAS DEL CACHE LRU ===\n";
+            RegistroMetricas& metricas = RegistroMetricas::global();
+            uint64_t totalConsultas = metricas.contador(Contador::CONSULTAS);
+            uint64_t hits = metricas.contador(Contador::HITS);
+            uint64_t misses = metricas.contador(Contador::MISSES);
+            std::cout << "\n  === METRICAS DEL CACHE (" << cache->politica() << ") ===\n";
             std::cout << "  -> Total de consultas procesadas: " << totalConsultas << "\n";
             std::cout << "  -> Total de aciertos [Hits]: " << hits << "\n";
             std::cout << "  -> Total de fallos [Misses]: " << misses << "\n";
@@ -442,17 +382,36 @@ void interfazConsultas(const Grafo& grafo, const std::map<std::string, double>&
                 std::cout << "  -> Tasa de fallos: 0%\n";
             }
             
-            std::cout << "  -> Numero de reemplazos/eliminaciones: " << reemplazos << "\n";
-            std::cout << "  -> Numero de inserciones en cache: " << inserciones << "\n";
-            std::cout << "  -> Elementos actuales en cache: " << cache->getSize() << "/" << cache->getMaxSize() << "\n";
+            std::cout << "  -> Numero de reemplazos/eliminaciones: " << metricas.contador(Contador::REEMPLAZOS) << "\n";
+            std::cout << "  -> Numero de inserciones en cache: " << metricas.contador(Contador::INSERCIONES) << "\n";
+            std::cout << "  -> Elementos actuales en cache: " << cache->getSize() << " (" << cache->getBytes() << "/" << cache->getMaxBytes() << " bytes)\n";
+            std::vector<EstadisticasFragmento> fragmentos = cache->estadisticas();
+            std::cout << "  -> Fragmentos del cache: " << fragmentos.size() << "\n";
+            for (size_t f = 0; f < fragmentos.size(); f++) {
+                std::cout << "     [" << f << "] elementos: " << fragmentos[f].elementos << " (" << fragmentos[f].bytes << " bytes), hits: " << fragmentos[f].hits
+                          << ", misses: " << fragmentos[f].misses << "\n";
+            }
+
+            // Latencia de cada etapa desde el arranque (log de consultas incluido), en microsegundos
+            std::cout << "\n  === LATENCIA POR ETAPA (us) ===\n";
+            std::cout << "  " << std::left << std::setw(12) << "etapa" << std::right << std::setw(10) << "cantidad"
+                      << std::setw(10) << "p50" << std::setw(10) << "p95" << std::setw(10) << "p99" << std::setw(10) << "max" << "\n";
+            for (uint32_t e = 0; e < static_cast<uint32_t>(Etapa::NUM_ETAPAS); e++) {
+                ResumenHistograma r = metricas.etapa(static_cast<Etapa>(e));
+                std::cout << "  " << std::left << std::setw(12) << nombreEtapa(static_cast<Etapa>(e)) << std::right << std::setw(10) << r.total
+                          << std::fixed << std::setprecision(2) << std::setw(10) << r.percentil(0.50) / 1000.0
+                          << std::setw(10) << r.percentil(0.95) / 1000.0 << std::setw(10) << r.percentil(0.99) / 1000.0
+                          << std::setw(10) << r.maximo / 1000.0 << std::defaultfloat << std::setprecision(6) << "\n";
+            }
             
-            if (!pagerank.empty()) {
-                auto maxPR = std::max_element(pagerank.begin(), pagerank.end(),
-                    [](const auto& a, const auto& b) { return a.second < b.second; });
-                auto minPR = std::min_element(pagerank.begin(), pagerank.end(),
-                    [](const auto& a, const auto& b) { return a.second < b.second; });
-                std::cout << "\n  -> PageRank maximo: " << maxPR->second << " (" << maxPR->first << ")\n";
-                std::cout << "  -> PageRank minimo: " << minPR->second << " (" << minPR->first << ")\n";
+            if (nodosConPR() > 0) {
+                uint32_t maxPR = 0, minPR = 0;
+                for (uint32_t u = 1; u < nodosConPR(); u++) {
+                    if (valorPR(u) > valorPR(maxPR)) maxPR = u;
+                    if (valorPR(u) < valorPR(minPR)) minPR = u;
+                }
+                std::cout << "\n  -> PageRank maximo: " << valorPR(maxPR) << " (" << grafo.url(maxPR) << ")\n";
+                std::cout << "  -> PageRank minimo: " << valorPR(minPR) << " (" << grafo.url(minPR) << ")\n";
             }
         }
         else if (accion == "limpiar-cache") {
@@ -461,27 +420,213 @@ void interfazConsultas(const Grafo& grafo, const std::map<std::string, double>&
             int elementosEliminados = cache->getSize();
             cache->clear();
             
-            // Reiniciar estadísticas del cache
-            hits = 0;
-            misses = 0;
-            totalConsultas = 0;
-            inserciones = 0;
-            reemplazos = 0;
+            // Reiniciar estadísticas del cache (las latencias por etapa se conservan)
+            RegistroMetricas::global().reiniciarContadores();
             
             std::cout << "✅ Cache y estadísticas limpiados exitosamente\n";
             std::cout << "   Elementos eliminados: " << elementosEliminados << "\n";
-            std::cout << "   Estado actual: " << cache->getSize() << "/" << cache->getMaxSize() << " elementos\n";
+            std::cout << "   Estado actual: " << cache->getSize() << " elementos, " << cache->getBytes() << "/" << cache->getMaxBytes() << " bytes\n";
             std::cout << "   Estadísticas reiniciadas: Hits=0, Misses=0, Total=0\n";
         }
+        else if (accion == "metrics-dump") {
+            std::string ruta = parametro.empty() ? "metricas.json" : parametro;
+            std::ofstream out(ruta);
+            if (!out.is_open()) {
+                std::cout << "❌ No se pudo crear " << ruta << "\n";
+                continue;
+            }
+            RegistroMetricas::global().escribirJSON(out);
+            std::cout << "✅ Metricas guardadas en " << ruta << "\n";
+        }
         else {
             std::cout << "⚠️ Comando no reconocido. Use 'salir' para terminar.\n";
-            std::cout << "📝 Comandos: grafo, pagerank, cache, buscar, top-pagerank, mostrar-cache, limpiar-cache, stats, salir\n";
+            std::cout << "📝 Comandos: grafo, pagerank, cache, buscar, top-pagerank, mostrar-cache, limpiar-cache, stats, modo, metrics-dump, salir\n";
         }
     }
 }
 
+// Suma el tamano y la fecha de modificacion de un archivo: identifican su version sin leerlo
+uint64_t sumarVersion(uint64_t h, const std::string& ruta) {
+    ArchivoIndice::VersionArchivo version = ArchivoIndice::versionDe(ruta);
+    uint64_t datos[] = {version.bytes, static_cast<uint64_t>(version.fecha)};
+    return ArchivoGrafo::sumar(h, datos, sizeof(datos));
+}
+
+// Firma de todo lo que determina el grafo y su PageRank: el contenido del log de consultas,
+// el indice, BM25, el modo y las opciones de PageRank. Un snapshot con otra firma esta viejo.
+// El indice se identifica sin recorrer sus postings: por la version del corpus, sus
+// stopwords y sus totales, y si se cargo de disco ('archivoIndice' no vacio) por la
+// cabecera y la version del archivo. Los termIDs no entran (dependen de --threads).
+uint64_t firmaEntradas(const std::string& logQueries, const std::string& corpus, const std::string& archivoIndice, const Indice& indice, const BM25& bm25, ModoConsulta modo, const OpcionesPageRank& opcionesPR) {
+    ArchivoMapeado log;
+    uint64_t h = 0;
+    if (log.abrir(logQueries)) h = ArchivoGrafo::sumar(h, log.data(), log.size());
+    h = sumarVersion(h, corpus);
+    if (!archivoIndice.empty() && indice.archivo) {
+        h = sumarVersion(h, archivoIndice);
+        h = ArchivoGrafo::sumar(h, indice.archivo->data(), sizeof(ArchivoIndice::Cabecera));
+    }
+    for (const std::string& stopword : indice.stopwords) h = ArchivoGrafo::sumar(h, stopword.data(), stopword.size() + 1);
+    uint64_t enteros[] = {indice.numDocumentos(), indice.numTerminos(), indice.numPostings(), indice.totalTerminos,
+                          static_cast<uint64_t>(modo), static_cast<uint64_t>(opcionesPR.maxIteraciones),
+                          static_cast<uint64_t>(opcionesPR.ponderado), static_cast<uint64_t>(opcionesPR.metodo)};
+    double reales[] = {bm25.k1, bm25.b, opcionesPR.d, opcionesPR.tolerancia};
+    h = ArchivoGrafo::sumar(h, enteros, sizeof(enteros));
+    return ArchivoGrafo::sumar(h, reales, sizeof(reales));
+}
+
+// Procesa el log de consultas: escribe ResultQueries.txt, llena el cache y arma el grafo
+// de co-relevancia con los resultados de cada consulta (sin grafo si ya se cargo de un
+// snapshot). Guarda las primeras consultas (y sus documentos) para comparar rankings.
+// Devuelve false si no pudo abrir los archivos.
+bool procesarLog(const std::string& logQueries, const std::string& resultadosFile, const Indice& indice, const BM25& bm25, ModoConsulta modo, const Stopwords& sw, CacheConcurrente<ResultadoConsulta, uint64_t>* cache, PoolHilos& pool, Grafo* grafo, std::vector<std::string>& consultasEjemplo, std::vector<std::vector<std::string>>& docsPorConsulta) {
+    std::cout << "Abriendo archivos de queries y resultados...\n";
+    std::ifstream queries(logQueries);
+    std::ofstream resultados(resultadosFile);
+    if (!queries.is_open()) {
+        std::cerr << "No se pudo abrir " << logQueries << "\n";
+        return false;
+    }
+    if (!resultados.is_open()) {
+        std::cerr << "No se pudo crear ResultQueries.txt\n";
+        return false;
+    }
+    std::cout << "✅ Se abrieron correctamente los archivos\n\n";
+
+    std::string consulta;
+    int numConsulta = 1;
+    int totalAristas = 0;
+
+    std::cout << "Procesando queries y generando ResultQueries.txt" << (grafo != nullptr ? " y grafo de co-relevancia" : "") << "...\n";
+    auto start_grafo = std::chrono::high_resolution_clock::now();
+
+    // Las consultas se evaluan por lotes en el pool de hilos; cada una escribe en su casilla
+    // y despues el lote se vuelca en orden, asi el archivo y el grafo no dependen de los hilos.
+    struct ConsultaProcesada {
+        std::string texto;
+        std::vector<DocResultado> docs;
+    };
+    const size_t TAM_LOTE = 1024;
+    std::vector<std::string> lote;
+    std::vector<ConsultaProcesada> procesadas;
+
+    // Las cliques de todas las consultas se juntan en un solo lote de aristas y se cargan
+    // en el grafo al final; el tiempo del grafo se mide aparte del de las consultas
+    std::vector<uint32_t> nodoDeDoc(indice.numDocumentos(), Grafo::SIN_NODO);
+    std::vector<uint64_t> clavesAristas;
+    std::chrono::duration<double, std::milli> tiempoConstruccionGrafo(0);
+
+    while (true) {
+        lote.clear();
+        while (lote.size() < TAM_LOTE && std::getline(queries, consulta)) {
+            lote.push_back(consulta);
+        }
+        if (lote.empty()) break;
+        procesadas.assign(lote.size(), ConsultaProcesada());
+
+        pool.ejecutar(lote.size(), [&](size_t i) {
+            RegistroMetricas& metricas = RegistroMetricas::global();
+            metricas.sumar(Contador::CONSULTAS);
+            ConsultaNormalizada normalizada = normalizarConsulta(lote[i], modo, sw);
+            ResultadoConsulta resultado;
+
+            // Verificar si la consulta esta en cache; en un hit no se vuelve a evaluar nada
+            CronometroEtapa medirCache(Etapa::CACHE);
+            bool acierto = cache->buscar(normalizada.clave, resultado);
+            medirCache.detener();
+            if (acierto) {
+                metricas.sumar(Contador::HITS);
+            } else {
+                // Cache miss - una sola evaluacion para la salida, el cache y el grafo
+                metricas.sumar(Contador::MISSES);
+                resultado = busqueda(indice, bm25, modo, normalizada);
+
+                // Solo cachear si el resultado es valido (con documentos encontrados)
+                if (!resultado.docs.empty()) {
+                    metricas.sumar(Contador::REEMPLAZOS, cache->insertar(normalizada.clave, resultado));
+                    metricas.sumar(Contador::INSERCIONES);
+                }
+            }
+            procesadas[i].texto = formatearResultado(indice, resultado);
+            procesadas[i].docs = std::move(resultado.docs);
+        });
+
+        // Actualizaciones del grafo y salida en el orden del log
+        auto inicioGrafoLote = std::chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < lote.size() && grafo != nullptr; i++) {
+            const std::vector<DocResultado>& docs = procesadas[i].docs;
+            totalAristas += (docs.size() * (docs.size() - 1)) / 2;
+            construirGrafo(*grafo, indice, docs, nodoDeDoc, clavesAristas);
+        }
+        tiempoConstruccionGrafo += std::chrono::high_resolution_clock::now() - inicioGrafoLote;
+        for (size_t i = 0; i < lote.size(); i++) {
+            resultados << "Consulta #" << numConsulta << ": " << lote[i] << "\n";
+            resultados << procesadas[i].texto << "\n";
+            // Guardar para comparacion de ranking
+            if (consultasEjemplo.size() < 5) {
+                consultasEjemplo.push_back(lote[i]);
+                docsPorConsulta.push_back(obtenerDocsRelevantes(indice, procesadas[i].docs));
+            }
+            numConsulta++;
+        }
+    }
+
+    std::cout << "✅ Consultas procesadas y resultados guardados en ResultQueries.txt\n\n";
+    queries.close();
+    resultados.close();
+
+    // El lote de aristas se agrega y se compacta en CSR antes de consultar el grafo
+    auto inicioCarga = std::chrono::high_resolution_clock::now();
+    if (grafo != nullptr) grafo->agregarLote(clavesAristas);
+    std::vector<uint64_t>().swap(clavesAristas);
+    auto end_grafo = std::chrono::high_resolution_clock::now();
+    tiempoConstruccionGrafo += end_grafo - inicioCarga;
+    std::chrono::duration<double, std::milli> tiempoConsultas = end_grafo - start_grafo;
+
+    if (grafo != nullptr) {
+        std::cout << "  -> Numero total de consultas usadas para construir el grafo: " << numConsulta-1 << std::endl;
+        std::cout << "  -> Numero de nodos en el grafo: " << grafo->numNodos() << std::endl;
+        std::cout << "  -> Numero de aristas en el grafo: " << grafo->numAristas() << std::endl;
+        std::cout << "  -> Tiempo de construccion del grafo: " << tiempoConstruccionGrafo.count() << " ms\n";
+        std::cout << "  -> Tiempo total de consultas y grafo: " << tiempoConsultas.count() << " ms\n";
+    } else {
+        std::cout << "  -> Numero total de consultas: " << numConsulta-1 << std::endl;
+        std::cout << "  -> Tiempo total de consultas: " << tiempoConsultas.count() << " ms\n";
+    }
+    std::cout << "  -> Hilos de consulta: " << pool.size() << " (" << (numConsulta - 1) / (tiempoConsultas.count() / 1000.0) << " consultas/s)\n\n";
+    return true;
+}
+
+// Ruta del indice binario de un corpus: gov1_pages.dat -> gov1_pages.idx
+std::string rutaIndice(const std::string& corpus) {
+    return std::filesystem::path(corpus).replace_extension(".idx").string();
+}
+
+// Construye el indice de cada corpus y lo guarda en disco (comando --construir-indice)
+int construirIndices(const std::vector<std::string>& corpus, const std::string& stopwords, unsigned hilos) {
+    for (const auto& archivo : corpus) {
+        std::cout << "Construyendo indice de " << archivo << "...\n";
+        Indice indice;
+        EstadisticasCarga carga = indiceInvertido(indice, stopwords, archivo, hilos);
+        if (carga.bytes == 0) return 1;
+        std::string ruta = rutaIndice(archivo);
+        if (!ArchivoIndice::guardar(indice, ruta, archivo)) return 1;
+        std::cout << "✅ " << ruta << ": " << indice.numDocumentos() << " documentos, "
+                  << indice.numTerminos() << " terminos, " << indice.numPostings() << " postings en "
+                  << indice.bytesPostings() << " bytes (" << carga.mbPorSegundo() << " MB/s)\n";
+    }
+    return 0;
+}
+
 // Funcion principal
-int main() {
+// Opciones: --k1 <valor> --b <valor> (parametros de BM25), --threads <n> (hilos de construccion y de consultas),
+// --corpus <archivo> (corpus a usar o a indexar), --construir-indice (guarda <corpus>.idx y termina),
+// --modo <and|or> (semantica de las consultas), --cache <bytes> (capacidad del cache; admite K, M y G),
+// --politica <lru|arc|s3fifo|tinylfu> (politica de desalojo del cache),
+// --fusion <ninguna|lineal|rrf> --fusion-peso <valor> --fusion-k <valor> (ranking con PageRank en la interfaz),
+// --snapshot <archivo> (carga o guarda el grafo y su PageRank), --sin-lista-adyacencia (no escribe ListaAdyacencia.txt),
+// --log <archivo> (log de consultas), --sin-metricas (no mide la latencia de cada etapa)
+int main(int argc, char* argv[]) {
     // Configurar consola para UTF-8 en Windows (Es por que le pusimos emojis al codigo)
     #ifdef _WIN32
         SetConsoleOutputCP(CP_UTF8);
@@ -494,171 +639,234 @@ int main() {
         SetConsoleMode(hOut, dwMode);
     #endif
     
+    BM25 bm25;
+    unsigned hilos = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::string> corpus;
+    bool soloConstruir = false;
+    ModoConsulta modo = ModoConsulta::OR;
+    size_t capacidadCache = size_t(1) << 20;
+    std::string politicaCache = "lru";
+    OpcionesPageRank opcionesPR;
+    bool grafoVivo = false;
+    OpcionesFusion fusion;
+    std::string rutaSnapshot;
+    bool listaAdyacencia = true;
+    double toleranciaIncremental = OpcionesPageRankIncremental().tolerancia;
+    std::string rutaLog;
+    for (int i = 1; i < argc; i++) {
+        std::string opcion = argv[i];
+        if (opcion == "--k1" && i + 1 < argc) {
+            bm25.k1 = std::stod(argv[++i]);
+        } else if (opcion == "--b" && i + 1 < argc) {
+            bm25.b = std::stod(argv[++i]);
+        } else if (opcion == "--threads" && i + 1 < argc) {
+            hilos = static_cast<unsigned>(std::max(1, std::stoi(argv[++i])));
+        } else if (opcion == "--corpus" && i + 1 < argc) {
+            corpus.push_back(argv[++i]);
+        } else if (opcion == "--modo" && i + 1 < argc) {
+            if (!leerModo(argv[++i], modo)) std::cerr << "⚠️ Modo desconocido: " << argv[i] << " (se usa or)\n";
+        } else if (opcion == "--cache" && i + 1 < argc) {
+            if (!leerBytes(argv[++i], capacidadCache)) std::cerr << "⚠️ Capacidad de cache invalida: " << argv[i] << " (se usa 1M)\n";
+        } else if (opcion == "--politica" && i + 1 < argc) {
+            politicaCache = argv[++i];
+            if (!politicaValida(politicaCache)) {
+                std::cerr << "⚠️ Politica de cache desconocida: " << politicaCache << " (se usa lru)\n";
+                politicaCache = "lru";
+            }
+        } else if (opcion == "--pr-tol" && i + 1 < argc) {
+            opcionesPR.tolerancia = std::stod(argv[++i]);
+        } else if (opcion == "--pr-iter" && i + 1 < argc) {
+            opcionesPR.maxIteraciones = std::max(1, std::stoi(argv[++i]));
+        } else if (opcion == "--pr-metodo" && i + 1 < argc) {
+            if (!leerMetodoPageRank(argv[++i], opcionesPR.metodo)) std::cerr << "⚠️ Metodo de PageRank desconocido: " << argv[i] << " (se usa pull)\n";
+        } else if (opcion == "--pr-ponderado") {
+            opcionesPR.ponderado = true;
+        } else if (opcion == "--pr-incremental") {
+            grafoVivo = true;
+        } else if (opcion == "--pr-tol-incremental" && i + 1 < argc) {
+            toleranciaIncremental = std::stod(argv[++i]);
+        } else if (opcion == "--fusion" && i + 1 < argc) {
+            if (!leerFusion(argv[++i], fusion.tipo)) std::cerr << "⚠️ Fusion desconocida: " << argv[i] << " (se usa ninguna)\n";
+        } else if (opcion == "--fusion-peso" && i + 1 < argc) {
+            fusion.peso = std::stod(argv[++i]);
+        } else if (opcion == "--fusion-k" && i + 1 < argc) {
+            fusion.kRRF = std::stod(argv[++i]);
+        } else if (opcion == "--log" && i + 1 < argc) {
+            rutaLog = argv[++i];
+        } else if (opcion == "--snapshot" && i + 1 < argc) {
+            rutaSnapshot = argv[++i];
+        } else if (opcion == "--sin-lista-adyacencia") {
+            listaAdyacencia = false;
+        } else if (opcion == "--sin-metricas") {
+            RegistroMetricas::global().activas = false;
+        } else if (opcion == "--construir-indice") {
+            soloConstruir = true;
+        } else {
+            std::cerr << "⚠️ Opcion desconocida: " << opcion << "\n";
+        }
+    }
+
     std::filesystem::path exePath = std::filesystem::current_path();
 
     std::string file_I = (exePath / "gov1_pages.dat").string();
     std::string file_C = (exePath / "gov2_pages.dat").string();
     std::string stopwords = (exePath / "stopwords_english.dat.txt").string();
     
-    std::string logQueries = (exePath / "Log-Queries.dat").string();
+    std::string logQueries = rutaLog.empty() ? (exePath / "Log-Queries.dat").string() : rutaLog;
     std::string resultadosFile = (exePath / "ResultQueries.txt").string();
 
-    std::map<std::string , Document*> map;
-    
-    // Crear cache LRU con tamano fijo de 50 consultas en el cache y metricas
-    LRUCache* cache = new LRUCache(50);
-    int cacheHits = 0;
-    int cacheMisses = 0;
-    int totalConsultasProcesadas = 0;
-    int cacheInserciones = 0;
-    int cacheReemplazos = 0;
-
-    std::cout << "Cargando stopwords...\n";
-    std::string sw[100];
-    int swCount = 0;
-    cargarStopwords(stopwords, sw, swCount);
-    std::cout << "✅ Stopwords cargadas\n\n";
-
-    std::cout << "Construyendo indice invertido...\n";
-    indiceInvertido(map, stopwords, file_I);
-    std::cout << "✅ Indice invertido construido\n\n";
-
-    std::cout << "Abriendo archivos de queries y resultados...\n";
-    std::ifstream queries(logQueries);
-    std::ofstream resultados(resultadosFile);
-    if (!queries.is_open()) {
-        std::cerr << "No se pudo abrir Log-Queries.dat\n";
-        return 1;
+    if (soloConstruir) {
+        if (corpus.empty()) {
+            corpus.push_back(file_I);
+            if (std::filesystem::exists(file_C)) corpus.push_back(file_C);
+        }
+        return construirIndices(corpus, stopwords, hilos);
     }
-    if (!resultados.is_open()) {
-        std::cerr << "No se pudo crear ResultQueries.txt\n";
-        return 1;
+    std::string corpusActivo = corpus.empty() ? file_I : corpus.front();
+
+    Indice indice;
+    
+    // Crear cache (1 MB y LRU por defecto, --cache y --politica para cambiarlos) con un fragmento por hilo
+    CacheConcurrente<ResultadoConsulta, uint64_t>* cache = new CacheConcurrente<ResultadoConsulta, uint64_t>(capacidadCache, hilos, politicaCache);
+
+    auto start_indice = std::chrono::high_resolution_clock::now();
+    std::string archivoIndice = rutaIndice(corpusActivo);
+    bool indiceGuardado = std::filesystem::exists(archivoIndice);
+    bool indiceDeArchivo = indiceGuardado && ArchivoIndice::abrir(indice, archivoIndice, corpusActivo);
+    if (indiceDeArchivo) {
+        auto end_indice = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double, std::milli> tiempoIndice = end_indice - start_indice;
+        std::cout << "✅ Indice cargado desde " << archivoIndice << "\n";
+        std::cout << "  -> Tiempo de carga del indice: " << tiempoIndice.count() << " ms\n";
+    } else {
+        std::cout << "Construyendo indice invertido de " << corpusActivo << "...\n";
+        EstadisticasCarga carga = indiceInvertido(indice, stopwords, corpusActivo, hilos);
+        auto end_indice = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double, std::milli> tiempoIndice = end_indice - start_indice;
+        // Un indice guardado que no se pudo usar (viejo o corrupto) se reemplaza por el nuevo
+        if (indiceGuardado && carga.bytes > 0 && ArchivoIndice::guardar(indice, archivoIndice, corpusActivo)) {
+            std::cout << "✅ Indice invertido construido y guardado de nuevo en " << archivoIndice << "\n";
+        } else {
+            std::cout << "✅ Indice invertido construido (use --construir-indice para guardarlo en disco)\n";
+        }
+        std::cout << "  -> Hilos de construccion: " << hilos << "\n";
+        std::cout << "  -> Tiempo de construccion del indice: " << tiempoIndice.count() << " ms\n";
+        std::cout << "  -> Velocidad de parseo: " << carga.mbPorSegundo() << " MB/s (" << carga.bytes << " bytes)\n";
     }
-    std::cout << "✅ Se abrieron correctamente los archivos\n\n";
 
-    std::string consulta;
-    int numConsulta = 1;
+    // Las stopwords de las consultas son las mismas con las que se construyo el indice
+    Stopwords sw(indice.stopwords);
+    std::cout << "  -> Stopwords: " << sw.size() << "\n";
+    std::cout << "  -> Documentos: " << indice.numDocumentos() << "\n";
+    std::cout << "  -> Postings: " << indice.numPostings() << " (" << indice.bytesPostings() << " bytes comprimidos, decodificacion "
+              << Compresion::nombreSIMD(Compresion::nivelSIMD()) << ")\n";
+    std::cout << "  -> Terminos: " << indice.numTerminos() << "\n\n";
+
+    PoolHilos pool(hilos);
     Grafo grafo;
-    int totalAristas = 0;
+    ResultadoPageRank resultadoPR;
     std::vector<std::string> consultasEjemplo;
     std::vector<std::vector<std::string>> docsPorConsulta;
-    std::vector<std::string> resultadosSinPR;
-
-    std::cout << "Procesando queries y generando ResultQueries.txt y grafo de co-relevancia...\n";
-    auto start_grafo = std::chrono::high_resolution_clock::now();
 
-    while (std::getline(queries, consulta)) {
-        std::string resultado;
-        totalConsultasProcesadas++; // Contar consulta procesada
-        
-        // Verificar si la consulta esta en cache
-        if (cache->contains(consulta)) {
-            // Cache hit
-            resultado = cache->get(consulta);
-            cacheHits++;
-        } else {
-            // Cache miss - calcular resultado
-            resultado = busqueda(map, sw, swCount, consulta);
-            
-            // Solo cachear si el resultado es valido (no es "No se encontraron documentos...")
-            if (resultado.find("No se encontraron documentos") == std::string::npos && 
-                resultado.find("No se ingresaron palabras") == std::string::npos) {
-                
-                // Verificar si el cache esta lleno para contar reemplazos
-                if (cache->getSize() >= cache->getMaxSize()) {
-                    cacheReemplazos++;
-                }
-                
-                cache->put(consulta, resultado);
-                cacheInserciones++; // Contar insercion
+    // Con --snapshot, el grafo y su PageRank se cargan del archivo si fue construido con las
+    // mismas entradas (el log se sigue evaluando para ResultQueries.txt, el cache y la
+    // comparacion de rankings, pero sin armar el grafo); si no, se arma el grafo y al final
+    // se guarda el snapshot
+    uint64_t firma = 0;
+    if (!rutaSnapshot.empty()) firma = firmaEntradas(logQueries, corpusActivo, indiceDeArchivo ? archivoIndice : std::string(), indice, bm25, modo, opcionesPR);
+    bool desdeSnapshot = false;
+    if (!rutaSnapshot.empty() && std::filesystem::exists(rutaSnapshot)) {
+        auto start_snapshot = std::chrono::high_resolution_clock::now();
+        uint64_t firmaArchivo = 0;
+        Grafo grafoArchivo;
+        ResultadoPageRank prArchivo;
+        if (ArchivoGrafo::abrir(grafoArchivo, prArchivo, firmaArchivo, rutaSnapshot)) {
+            if (firmaArchivo == firma) {
+                grafo = std::move(grafoArchivo);
+                resultadoPR = std::move(prArchivo);
+                desdeSnapshot = true;
+                std::chrono::duration<double, std::milli> tiempoSnapshot = std::chrono::high_resolution_clock::now() - start_snapshot;
+                std::cout << "✅ Grafo y PageRank cargados desde " << rutaSnapshot << " (el log se evalua sin armar el grafo)\n";
+                std::cout << "  -> Numero de nodos en el grafo: " << grafo.numNodos() << "\n";
+                std::cout << "  -> Numero de aristas en el grafo: " << grafo.numAristas() << "\n";
+                std::cout << "  -> Tiempo de carga del snapshot: " << tiempoSnapshot.count() << " ms\n\n";
+            } else {
+                std::cout << "⚠️ " << rutaSnapshot << " se construyo con otro log, indice u opciones; se vuelve a generar\n";
             }
-            
-            cacheMisses++;
         }
+    }
 
-        // --- Nuevo: obtener documentos relevantes y construir el grafo ---
-        std::map<std::string, int> frecuenciaURLs;
-        listaString* palabras = nullptr;
-        std::istringstream ss(consulta);
-        std::string palabra;
-        while (ss >> palabra) {
-            std::transform(palabra.begin(), palabra.end(), palabra.begin(), [](unsigned char c) {
-                return std::tolower(c);
-            });
-            if (esStopword(palabra, sw, swCount)) continue;
-            listaString* nuevoNodo = new listaString(palabra);
-            if (palabras == nullptr) {
-                palabras = nuevoNodo;
-            } else {
-                listaString* aux = palabras;
-                while (aux->next != nullptr) aux = aux->next;
-                aux->next = nuevoNodo;
+    // Con --pr-incremental el CSR se arma desde el principio con espacio libre para las
+    // aristas de las consultas interactivas (un grafo del snapshot lo gana en la primera)
+    if (grafoVivo) grafo.holgura = 0.25;
+    if (!procesarLog(logQueries, resultadosFile, indice, bm25, modo, sw, cache, pool, desdeSnapshot ? nullptr : &grafo, consultasEjemplo, docsPorConsulta)) return 1;
+
+    // Exportacion de texto opcional (--sin-lista-adyacencia para omitirla)
+    if (listaAdyacencia) {
+        std::cout << "Guardando la lista de adyacencia en ListaAdyacencia.txt...\n";
+        grafo.guardarEnArchivo("ListaAdyacencia.txt");
+        std::cout << "✅ Grafo guardado en ListaAdyacencia.txt\n\n";
+    }
+
+    if (!desdeSnapshot) {
+        // Calcular PageRank y medir tiempo
+        std::cout << "Calculando PageRank...\n";
+        auto start_pr = std::chrono::high_resolution_clock::now();
+        // PageRank con convergencia (--pr-tol, --pr-iter, --pr-ponderado, --pr-metodo) en el pool de hilos
+        resultadoPR = grafo.calcularPageRank(opcionesPR, &pool);
+        auto end_pr = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double, std::milli> tiempoPR = end_pr - start_pr;
+        std::cout << "✅ PageRank calculado\n\n";
+        std::cout << "  -> Metodo de PageRank: " << nombreMetodo(opcionesPR.metodo) << " (" << pool.size() << " hilos)\n";
+        std::cout << "  -> Iteraciones de PageRank: " << resultadoPR.iteraciones << " (residuo L1: " << resultadoPR.residuo << ")" << std::endl;
+        std::cout << "  -> Tiempo de calculo de PageRank: " << tiempoPR.count() << " ms\n";
+
+        if (!rutaSnapshot.empty()) {
+            auto start_snapshot = std::chrono::high_resolution_clock::now();
+            if (ArchivoGrafo::guardar(grafo, resultadoPR, firma, rutaSnapshot)) {
+                std::chrono::duration<double, std::milli> tiempoSnapshot = std::chrono::high_resolution_clock::now() - start_snapshot;
+                std::cout << "✅ Snapshot del grafo y PageRank guardado en " << rutaSnapshot << " (" << tiempoSnapshot.count() << " ms)\n";
             }
         }
-        listaString* key = palabras;
-        while (key != nullptr) {
-            auto it = map.find(key->value);
-            if (it != map.end()) {
-                Document* doc = it->second;
-                while (doc != nullptr) {
-                    frecuenciaURLs[doc->url] += doc->frecuencia;
-                    doc = doc->next;
-                }
-            }
-            key = key->next;
+    } else {
+        std::cout << "  -> Iteraciones de PageRank: " << resultadoPR.iteraciones << " (residuo L1: " << resultadoPR.residuo << ", del snapshot)" << std::endl;
+    }
+    const std::vector<double>& pagerank = resultadoPR.valores;
+
+    // Ranking con PageRank: el indice se renumera por el PageRank de cada documento (0 para
+    // los que no estan en el grafo) y se compara con las primeras consultas del log
+    IndiceEstatico indiceEstatico;
+    if (fusion.tipo != Fusion::NINGUNA) {
+        auto start_estatico = std::chrono::high_resolution_clock::now();
+        std::vector<double> pagerankPorDoc(indice.numDocumentos(), 0.0);
+        for (uint32_t d = 0; d < pagerankPorDoc.size(); d++) {
+            uint32_t u = grafo.buscarNodo(indice.url(d));
+            if (u != Grafo::SIN_NODO) pagerankPorDoc[d] = pagerank[u];
         }
-        std::vector<std::string> docsRelevantes = obtenerDocsRelevantes(frecuenciaURLs);
-        totalAristas += (docsRelevantes.size() * (docsRelevantes.size() - 1)) / 2;
-        construirGrafo(grafo, docsRelevantes);
-        resultados << "Consulta #" << numConsulta << ": " << consulta << "\n";
-        resultados << resultado << "\n";
-        // Guardar para comparacion de ranking
-        if (consultasEjemplo.size() < 5) {
-            consultasEjemplo.push_back(consulta);
-            docsPorConsulta.push_back(docsRelevantes);
-            resultadosSinPR.push_back(resultado);
+        std::vector<uint32_t> nuevoDocID = indiceEstatico.construir(indice, pagerankPorDoc);
+        // Los resultados del log quedaron en el cache con los docIDs anteriores
+        cache->transformar([&](ResultadoConsulta& resultado) {
+            for (auto& doc : resultado.docs) doc.docID = nuevoDocID[doc.docID];
+        });
+        std::chrono::duration<double, std::milli> tiempoEstatico = std::chrono::high_resolution_clock::now() - start_estatico;
+        std::cout << "\n✅ Indice ordenado por PageRank (fusion " << nombreFusion(fusion.tipo) << ") en " << tiempoEstatico.count() << " ms\n";
+        if (grafoVivo) std::cout << "  -> La fusion usa el PageRank del arranque: el incremental no cambia el orden estatico\n";
+
+        if (!consultasEjemplo.empty()) std::cout << "\n=== COMPARACION DE RANKING (BM25 vs BM25 + PageRank) ===\n";
+        for (size_t i = 0; i < consultasEjemplo.size(); i++) {
+            ResultadoConsulta fusionado = busqueda(indice, bm25, modo, normalizarConsulta(consultasEjemplo[i], modo, sw), &indiceEstatico, fusion);
+            std::vector<std::string> docsFusion = obtenerDocsRelevantes(indice, fusionado.docs);
+            size_t comunes = 0;
+            for (const auto& url : docsFusion) {
+                comunes += std::find(docsPorConsulta[i].begin(), docsPorConsulta[i].end(), url) != docsPorConsulta[i].end();
+            }
+            std::cout << "Consulta: " << consultasEjemplo[i] << " (" << comunes << " de " << docsFusion.size() << " documentos en comun)\n";
+            for (size_t j = 0; j < 3 && j < std::max(docsFusion.size(), docsPorConsulta[i].size()); j++) {
+                std::cout << "  " << (j + 1) << ". BM25: " << (j < docsPorConsulta[i].size() ? docsPorConsulta[i][j] : "-")
+                          << " | fusion: " << (j < docsFusion.size() ? docsFusion[j] : "-") << "\n";
+            }
         }
-        numConsulta++;
-    }
-    std::cout << "✅ Consultas procesadas y resultados guardados en ResultQueries.txt\n\n";
-    queries.close();
-    resultados.close();
-    auto end_grafo = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double, std::milli> tiempoConstruccionGrafo = end_grafo - start_grafo;
-
-    // Metricas del grafo
-    int numNodos = grafo.adj.size();
-    int numAristas = 0;
-    for (const auto& par : grafo.adj) {
-        numAristas += par.second.size();
     }
-    numAristas /= 2; // No dirigido
-
-    std::cout << "  -> Numero total de consultas usadas para construir el grafo: " << numConsulta-1 << std::endl;
-    std::cout << "  -> Numero de nodos en el grafo: " << numNodos << std::endl;
-    std::cout << "  -> Numero de aristas en el grafo: " << numAristas << std::endl;
-    std::cout << "  -> Tiempo de construccion del grafo: " << tiempoConstruccionGrafo.count() << " ms\n\n";
-
-    std::cout << "Guardando la lista de adyacencia en ListaAdyacencia.txt...\n";
-    grafo.guardarEnArchivo("ListaAdyacencia.txt");
-    std::cout << "✅ Grafo guardado en ListaAdyacencia.txt\n\n";
-
-    // Calcular PageRank y medir tiempo
-    std::cout << "Calculando PageRank...\n";
-    auto start_pr = std::chrono::high_resolution_clock::now();
-    int iteracionesPR = 0;
-    std::map<std::string, double> pagerank;
-    double d = 0.85;
-    int maxIter = 100;
-
-    // PageRank con convergencia
-    pagerank = grafo.calcularPageRank(maxIter, d);
-    iteracionesPR = maxIter; // (No hay convergencia real, solo iteraciones fijas)
-    auto end_pr = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double, std::milli> tiempoPR = end_pr - start_pr;
-    std::cout << "✅ PageRank calculado\n\n";
-    std::cout << "  -> Iteraciones de PageRank: " << iteracionesPR << std::endl;
-    std::cout << "  -> Tiempo de calculo de PageRank: " << tiempoPR.count() << " ms\n";
 
     // Interfaz interactiva para consultas
     std::cout << "\nDesea usar la interfaz de consultas interactiva? (s/n): ";
@@ -667,7 +875,17 @@ int main() {
     std::cin.ignore(); // Limpiar buffer
     
     if (respuesta == 's' || respuesta == 'S') {
-        interfazConsultas(grafo, pagerank, cache, map, sw, swCount, totalConsultasProcesadas, cacheHits, cacheMisses, cacheInserciones, cacheReemplazos);
+        // Con --pr-incremental el PageRank parte del ya calculado y se mantiene mientras crece
+        // el grafo
+        std::unique_ptr<PageRankIncremental> prIncremental;
+        if (grafoVivo) {
+            OpcionesPageRankIncremental opcionesIncremental;
+            opcionesIncremental.d = opcionesPR.d;
+            opcionesIncremental.tolerancia = toleranciaIncremental;
+            opcionesIncremental.ponderado = opcionesPR.ponderado;
+            prIncremental = std::make_unique<PageRankIncremental>(grafo, pagerank, opcionesIncremental);
+        }
+        interfazConsultas(grafo, pagerank, prIncremental.get(), cache, indice, indiceEstatico, fusion, bm25, modo, sw);
     }
 
     std::cout << "\nPrograma finalizado correctamente.\n";
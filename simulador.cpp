@@ -0,0 +1,91 @@
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "Evaluacion.h"
+#include "PoliticasCache.h"
+#include "Stopwords.h"
+
+// Simulador de politicas de cache: reproduce Log-Queries.dat (con las mismas claves
+// canonicas que usa main) sobre cada politica y un rango de capacidades, y reporta la
+// tasa de aciertos y las operaciones por segundo. Cada consulta hace un get y, si falla,
+// un put de un resultado de 10 documentos (el tamano tipico de una entrada real).
+// Opciones: --log <archivo> --stopwords <archivo> --min <bytes> --max <bytes> --modo <and|or>
+int main(int argc, char* argv[]) {
+    std::string logQueries = "Log-Queries.dat";
+    std::string stopwordsFile = "stopwords_english.dat.txt";
+    size_t minBytes = size_t(4) << 10;
+    size_t maxBytes = size_t(1) << 20;
+    ModoConsulta modo = ModoConsulta::OR;
+    for (int i = 1; i < argc; i++) {
+        std::string opcion = argv[i];
+        if (opcion == "--log" && i + 1 < argc) {
+            logQueries = argv[++i];
+        } else if (opcion == "--stopwords" && i + 1 < argc) {
+            stopwordsFile = argv[++i];
+        } else if ((opcion == "--min" || opcion == "--max") && i + 1 < argc) {
+            // Las capacidades se duplican desde --min: tiene que ser al menos 1 byte
+            size_t bytes = 0;
+            if (leerBytes(argv[++i], bytes) && bytes >= 1) {
+                (opcion == "--min" ? minBytes : maxBytes) = bytes;
+            } else {
+                std::cerr << "⚠️ Capacidad invalida: " << argv[i] << " (debe ser de al menos 1 byte)\n";
+            }
+        } else if (opcion == "--modo" && i + 1 < argc) {
+            if (!leerModo(argv[++i], modo)) std::cerr << "⚠️ Modo desconocido: " << argv[i] << " (se usa or)\n";
+        } else {
+            std::cerr << "⚠️ Opcion desconocida: " << opcion << "\n";
+        }
+    }
+
+    Stopwords stopwords;
+    if (!stopwords.cargar(stopwordsFile)) return 1;
+
+    std::ifstream queries(logQueries);
+    if (!queries.is_open()) {
+        std::cerr << "❌ No se pudo abrir " << logQueries << "\n";
+        return 1;
+    }
+    std::vector<uint64_t> claves;
+    std::string linea;
+    while (std::getline(queries, linea)) {
+        ConsultaNormalizada consulta = normalizarConsulta(linea, modo, stopwords);
+        if (!consulta.terminos.empty()) claves.push_back(consulta.clave);
+    }
+    std::unordered_set<uint64_t> distintas(claves.begin(), claves.end());
+    std::cout << "Consultas: " << claves.size() << " (" << distintas.size() << " distintas)\n\n";
+
+    ResultadoConsulta resultado;
+    for (uint32_t d = 0; d < 10; d++) resultado.docs.push_back({d, 1.0f});
+
+    std::cout << std::left << std::setw(10) << "politica" << std::right << std::setw(12) << "capacidad"
+              << std::setw(10) << "entradas" << std::setw(12) << "aciertos" << std::setw(14) << "ops/s" << "\n";
+    for (size_t capacidad = minBytes; capacidad <= maxBytes; capacidad *= 2) {
+        for (const std::string& politica : nombresPoliticas()) {
+            std::unique_ptr<CacheBase<ResultadoConsulta, uint64_t>> cache = crearCache<ResultadoConsulta, uint64_t>(politica, capacidad);
+            size_t hits = 0, operaciones = 0;
+            ResultadoConsulta valor;
+            auto inicio = std::chrono::steady_clock::now();
+            for (uint64_t clave : claves) {
+                operaciones++;
+                if (cache->get(clave, valor)) {
+                    hits++;
+                } else {
+                    operaciones++;
+                    cache->put(clave, resultado);
+                }
+            }
+            std::chrono::duration<double> duracion = std::chrono::steady_clock::now() - inicio;
+            double tasa = claves.empty() ? 0.0 : 100.0 * hits / claves.size();
+            std::cout << std::left << std::setw(10) << politica << std::right << std::setw(12) << capacidad
+                      << std::setw(10) << cache->getSize() << std::setw(11) << std::fixed << std::setprecision(2) << tasa << "%"
+                      << std::setw(14) << std::setprecision(0) << (duracion.count() > 0 ? operaciones / duracion.count() : 0.0) << "\n";
+            std::cout.unsetf(std::ios::fixed);
+        }
+        if (capacidad > maxBytes / 2) break; // evita el desborde al duplicar
+    }
+    return 0;
+}